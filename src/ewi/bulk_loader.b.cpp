@@ -0,0 +1,128 @@
+// bulk_loader.b.cpp
+// BulkLoader Scaling Benchmark Driver
+//
+// Usage: bench_bulk_loader [num_users] [entries_per_record] [max_threads]
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "bulk_loader.hpp"
+//- STL
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <ewi/employee_record.hpp>
+
+using namespace ewi;
+using Clock = std::chrono::steady_clock;
+namespace fs = std::filesystem;
+
+namespace
+{
+    /// Builds a user with two jobs of daily entries.
+    auto gen_user(int user, int num_entries) -> EmployeeRecord
+    {
+        using namespace std::chrono;
+        auto id = std::to_string(100000 + user);
+        EmployeeRecord rec { Employee{ EmployeeID{ id }, "Synthetic User " + id } };
+        for (int j {0}; j < 2; ++j)
+        {
+            std::vector<Entry> tech {}, pers {};
+            sys_days day { 2015y / January / 1d };
+            for (int i {0}; i < num_entries; ++i, day += days{1})
+            {
+                double x = (i * 7 + user + j) % 13;
+                tech.emplace_back(year_month_day{ day }, (i % 5 == 0) ? std::string("Reviewed PRs.") : std::string(),
+                        std::vector<double>{ x, x / 2., 3., -x });
+                pers.emplace_back(year_month_day{ day }, std::string(), std::vector<double>{ x / 3., 1. });
+            }
+            rec.add(JobID{ "JOB" + std::to_string(j) }, WIRecord{ Record(tech), Record(pers) });
+        }
+        return rec;
+    }
+
+    template<typename F>
+    auto time_best_of(int runs, F&& f) -> double
+    {
+        double best { 1e300 };
+        for (int i {0}; i < runs; ++i)
+        {
+            auto start = Clock::now();
+            f();
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+}
+
+void bench_scaling(int num_users, int num_entries, unsigned max_threads);
+
+int main(int argc, char* argv[])
+{
+    int num_users { argc > 1 ? std::atoi(argv[1]) : 2'000 };
+    int num_entries { argc > 2 ? std::atoi(argv[2]) : 250 };
+    unsigned max_threads { argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : std::thread::hardware_concurrency() };
+    try {
+        bench_scaling(num_users, num_entries, std::max(1u, max_threads));
+    } catch (cpperrors::Exception const& e) {
+        std::cerr << e.report(true) << "\n";
+        return 1;
+    }
+}
+//--------------------------------------------------------------------------------------------------
+/// Loads a directory of synthetic user files with 1, 2, 4, ... threads up to `max_threads`
+/// (the hardware concurrency by default), reporting throughput and speedup over the
+/// single-threaded load.
+void bench_scaling(int num_users, int num_entries, unsigned max_threads)
+{
+    fs::path const dir { "bench_usr" };
+    fs::remove_all(dir);
+    fs::create_directory(dir);
+    for (int u {0}; u < num_users; ++u)
+    {
+        auto rec = gen_user(u, num_entries);
+        EmployeeRecordIOUtils::export_record(rec, (dir / (rec.who().id.formal() + ".txt")).string());
+    }
+
+    std::vector<unsigned> counts {};
+    for (unsigned t {1}; t < max_threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(max_threads);
+
+    std::cout << "<bench_scaling> " << num_users << " files, " << num_entries * 4 << " entries each\n";
+    double baseline {};
+    for (auto threads : counts)
+    {
+        double secs = time_best_of(3, [&] {
+            auto result = BulkLoader::import_directory(dir.string(), threads);
+            if (!result.errors.empty() || result.records.size() != static_cast<std::size_t>(num_users))
+                throw cpperrors::Exception("Bulk load did not return every file.");
+        });
+        if (threads == 1)
+            baseline = secs;
+        std::cout << "  " << threads << " thread(s): " << secs * 1e3 << " ms ("
+            << num_users / secs << " files/s, speedup " << baseline / secs << "x)\n";
+    }
+    fs::remove_all(dir);
+}
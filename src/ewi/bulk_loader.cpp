@@ -0,0 +1,118 @@
+// bulk_loader.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "bulk_loader.hpp"
+//- STL
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <ewi/employee_record.hpp>
+
+
+using cpperrors::Exception, cpperrors::TypedException;
+namespace fs = std::filesystem;
+namespace ewi
+{
+    auto BulkLoader::import_records(std::vector<std::string> const& paths, unsigned num_threads) -> BulkLoadResult
+    {
+        std::vector<std::string> sorted { paths };
+        std::sort(sorted.begin(), sorted.end());
+
+        // Each file owns one slot, so workers never contend on anything except the
+        // counter that hands out the next file.
+        std::vector<std::optional<EmployeeRecord>> loaded (sorted.size());
+        std::vector<std::string> failures (sorted.size());
+        std::atomic<std::size_t> next {0};
+        auto worker = [&]() {
+            for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < sorted.size();
+                    i = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                try {
+                    loaded[i].emplace(EmployeeRecordIOUtils::import_record(sorted[i]));
+                } catch (Exception const& e) {
+                    failures[i] = e.what();
+                } catch (TypedException<std::string> const& e) {
+                    // Ex. unterminated notes.
+                    failures[i] = e.err().what();
+                } catch (std::exception const& e) {
+                    failures[i] = e.what();
+                } catch (...) {
+                    // Nothing may escape the thread, or the whole batch is terminated.
+                    // Reported as an unknown error below.
+                }
+                if (!loaded[i] && failures[i].empty())
+                    failures[i] = "Unknown error.";
+            }
+        };
+
+        if (num_threads == 0)
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        num_threads = static_cast<unsigned>(std::min<std::size_t>(num_threads, sorted.size()));
+        if (num_threads <= 1)
+            worker();
+        else
+        {
+            std::vector<std::jthread> pool {};
+            pool.reserve(num_threads);
+            for (unsigned t {0}; t < num_threads; ++t)
+                pool.emplace_back(worker);
+        }  // jthreads join here.
+
+        BulkLoadResult result {};
+        result.records.reserve(sorted.size());
+        for (std::size_t i {0}; i < sorted.size(); ++i)
+        {
+            if (loaded[i])
+                result.records.push_back(std::move(*loaded[i]));
+            else
+                result.errors.push_back(LoadError{ std::move(sorted[i]), std::move(failures[i]) });
+        }
+        return result;
+    }
+
+    auto BulkLoader::import_directory(std::string const& dir, unsigned num_threads) -> BulkLoadResult
+    {
+        std::error_code ec {};
+        fs::directory_iterator it { dir, ec };
+        if (ec)
+            throw Exception("Could not read directory: " + dir);
+
+        std::vector<std::string> paths {};
+        for (; it != fs::directory_iterator{}; it.increment(ec))
+        {
+            std::error_code type_ec {};
+            if (!it->is_regular_file(type_ec))
+                continue;
+            auto ext = it->path().extension().string();
+            if (std::ranges::find(RECORD_EXTS, ext) != std::end(RECORD_EXTS))
+                paths.push_back(it->path().string());
+        }
+        if (ec)
+            throw Exception("Could not read directory: " + dir);
+        return import_records(paths, num_threads);
+    }
+} // namespace ewi
@@ -0,0 +1,68 @@
+// bulk_loader.hpp
+/// Loads many employee record files at once (ex. every profile in the user directory),
+/// spreading the reading and parsing across a pool of threads.
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_EWI_BULK_LOADER
+#define INCLUDED_EWI_BULK_LOADER
+
+#ifndef INCLUDED_EWI_EMPLOYEE_RECORD
+#include <ewi/employee_record.hpp>
+#endif
+
+#ifndef INCLUDED_STD_STRING
+#include <string>
+#define INCLUDED_STD_STRING
+#endif
+
+#ifndef INCLUDED_STD_VECTOR
+#include <vector>
+#define INCLUDED_STD_VECTOR
+#endif
+
+namespace ewi
+{
+    /// A file that could not be loaded and the reason why.
+    struct LoadError
+    {
+        std::string path;
+        std::string message;
+    };
+
+    /// The outcome of a bulk load. Records and errors are each ordered by file path,
+    /// independent of the number of threads used.
+    struct BulkLoadResult
+    {
+        std::vector<EmployeeRecord> records {};
+        std::vector<LoadError> errors {};
+    };
+
+    struct BulkLoader
+    {
+        /// Extensions of the files `import_directory` considers record files.
+        static constexpr char const* RECORD_EXTS[] { ".txt", EmployeeRecordIOUtils::BINARY_EXT };
+
+        /// Imports each file with `EmployeeRecordIOUtils::import_record` using up to
+        /// `num_threads` threads (0 uses the hardware concurrency). A file that fails to
+        /// load is reported in `errors` and does not stop the rest of the batch.
+        static auto import_records(std::vector<std::string> const& paths, unsigned num_threads=0) -> BulkLoadResult;
+        /// Imports every record file directly within `dir` (see `RECORD_EXTS`).
+        /// Throws an exception if the directory cannot be read.
+        static auto import_directory(std::string const& dir, unsigned num_threads=0) -> BulkLoadResult;
+    };
+} // namespace ewi
+#endif // INCLUDED_EWI_BULK_LOADER
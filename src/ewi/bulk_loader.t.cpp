@@ -0,0 +1,111 @@
+// bulk_loader.t.cpp
+// BulkLoader Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "bulk_loader.hpp"
+//- STL
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <ewi/employee_record.hpp>
+
+using namespace ewi;
+using namespace std::chrono_literals;
+namespace fs = std::filesystem;
+
+void test_import_directory();
+
+int main()
+{
+    try {
+        test_import_directory();
+    } catch (cpperrors::Exception const& e) {
+        std::cerr << e.report(true) << "\n";
+        throw;
+    }
+}
+//--------------------------------------------------------------------------------------------------
+namespace
+{
+    auto make_user(int n) -> EmployeeRecord
+    {
+        auto id = std::to_string(10000 + n);
+        EmployeeRecord rec { Employee{ EmployeeID{ id }, "User " + id } };
+        for (int d {1}; d <= n % 5 + 1; ++d)
+        {
+            auto date = 2024y / std::chrono::May / std::chrono::day(d);
+            rec.add(JobID{ "J" + std::to_string(n % 3) }, RecordType::Technical, Entry(date, "Notes", std::vector<double>{ 1. * n, 2. }));
+        }
+        return rec;
+    }
+}
+
+/// Every valid file is loaded regardless of thread count; bad files are reported
+/// individually and other files are ignored.
+void test_import_directory()
+{
+    fs::path const dir { "bulk_loader_usr" };
+    fs::remove_all(dir);
+    fs::create_directory(dir);
+
+    std::vector<EmployeeRecord> expected {};
+    for (int n {0}; n < 40; ++n)
+    {
+        expected.push_back(make_user(n));
+        auto path = (dir / expected.back().who().id.formal()).string();
+        if (n % 4 == 0)
+            EmployeeRecordIOUtils::export_record_binary(expected.back(), path + EmployeeRecordIOUtils::BINARY_EXT);
+        else
+            EmployeeRecordIOUtils::export_record(expected.back(), path + ".txt");
+    }
+    std::ofstream { dir / "broken.txt" } << "00001 Broken Record\n\nJ0 T 2024-13-45 \"\" 1\n";
+    std::ofstream { dir / "unterminated.txt" } << "00002 Unterminated Notes\n\nJ0 T 2024-05-01 '''Never closed 1\n";
+    std::ofstream { dir / "notes.md" } << "Ignored.\n";
+    fs::create_directory(dir / "nested.txt");
+
+    for (unsigned threads : { 1u, 3u, 8u, 0u })
+    {
+        auto result = BulkLoader::import_directory(dir.string(), threads);
+        assert(result.records == expected);
+        assert(result.errors.size() == 2);
+        assert(fs::path(result.errors[0].path).filename() == "broken.txt");
+        assert(fs::path(result.errors[1].path).filename() == "unterminated.txt");
+        for (auto const& error: result.errors)
+            assert(!error.message.empty());
+    }
+
+    // Missing files are errors, not exceptions.
+    auto missing = BulkLoader::import_records({ (dir / "missing.txt").string() }, 2);
+    assert(missing.records.empty() && missing.errors.size() == 1);
+    assert(BulkLoader::import_records({}).records.empty());
+
+    bool threw { false };
+    try {
+        BulkLoader::import_directory("no_such_directory");
+    } catch (cpperrors::Exception const&) {
+        threw = true;
+    }
+    assert(threw);
+    fs::remove_all(dir);
+}
@@ -0,0 +1,231 @@
+// calendar_rollup.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "calendar_rollup.hpp"
+//- STL
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+//- In-house
+#include "day_index.hpp"
+
+
+namespace
+{
+    auto day_number(std::chrono::sys_days day) noexcept -> std::int32_t
+    {
+        return static_cast<std::int32_t>(day.time_since_epoch().count());
+    }
+}
+
+namespace ewi
+{
+    auto CalendarRollup::period_start(CalendarPeriod period, std::chrono::year_month_day date) noexcept -> std::chrono::sys_days
+    {
+        using namespace std::chrono;
+        switch (period)
+        {
+            case CalendarPeriod::Week:
+            {
+                sys_days const day { date };
+                return day - days{ weekday{ day }.iso_encoding() - 1 };
+            }
+            case CalendarPeriod::Month:
+                return sys_days{ date.year() / date.month() / 1d };
+            case CalendarPeriod::Quarter:
+            {
+                unsigned const first_month { (unsigned{ date.month() } - 1) / 3 * 3 + 1 };
+                return sys_days{ date.year() / month{ first_month } / 1d };
+            }
+            case CalendarPeriod::Year:
+            default:
+                return sys_days{ date.year() / January / 1d };
+        }
+    }
+
+    auto CalendarRollup::summarize(
+            CalendarPeriod period,
+            std::optional<std::chrono::year_month_day> min,
+            std::optional<std::chrono::year_month_day> max
+    ) const -> PeriodSummaries
+    {
+        auto const& table = d_tables[static_cast<int>(period)];
+        auto first = table.starts.begin();
+        auto last = table.starts.end();
+        if (min)
+            first = std::lower_bound(first, last, day_number(period_start(period, *min)));
+        if (max)
+            last = std::upper_bound(first, last, day_number(std::chrono::sys_days{ *max }));
+
+        PeriodSummaries out { .dim=d_dim };
+        auto const count = static_cast<std::size_t>(last - first);
+        auto const dim = static_cast<std::size_t>(d_dim);
+        out.starts.reserve(count);
+        out.counts.reserve(count);
+        out.means.resize(count * dim);
+        for (auto i = static_cast<std::size_t>(first - table.starts.begin()), row = std::size_t{0}; row < count; ++i, ++row)
+        {
+            out.starts.emplace_back(std::chrono::sys_days{ std::chrono::days{ table.starts[i] } });
+            out.counts.push_back(table.counts[i]);
+            double const n = table.counts[i];
+            for (std::size_t col {0}; col < dim; ++col)
+                out.means[row * dim + col] = table.sums[i * dim + col] / n;
+        }
+        return out;
+    }
+
+    void CalendarRollup::add(std::chrono::year_month_day date, std::span<double const> metrics)
+    {
+        if (d_count == 0)
+            d_dim = static_cast<int>(metrics.size());
+        assert(static_cast<int>(metrics.size()) == d_dim);
+        auto const dim = static_cast<std::ptrdiff_t>(d_dim);
+        for (int p {0}; p < NUM_PERIODS; ++p)
+        {
+            auto& table = d_tables[p];
+            auto const start = day_number(period_start(static_cast<CalendarPeriod>(p), date));
+            // Entries usually arrive in date order, landing in the latest period.
+            auto pos = (table.starts.empty() || start > table.starts.back())
+                ? table.starts.end()
+                : std::lower_bound(table.starts.begin(), table.starts.end(), start);
+            auto const idx = pos - table.starts.begin();
+            if (pos == table.starts.end() || *pos != start)
+            {
+                table.starts.insert(pos, start);
+                table.counts.insert(table.counts.begin() + idx, 0);
+                table.sums.insert(table.sums.begin() + idx * dim, static_cast<std::size_t>(dim), 0.);
+            }
+            ++table.counts[idx];
+            auto const sums = table.sums.begin() + idx * dim;
+            std::transform(metrics.begin(), metrics.end(), sums, sums, std::plus{});
+        }
+        ++d_count;
+    }
+
+    void CalendarRollup::remove(std::chrono::year_month_day date, std::span<double const> metrics)
+    {
+        assert(static_cast<int>(metrics.size()) == d_dim);
+        if (d_count == 1)
+        {
+            clear();
+            return;
+        }
+        auto const dim = static_cast<std::ptrdiff_t>(d_dim);
+        for (int p {0}; p < NUM_PERIODS; ++p)
+        {
+            auto& table = d_tables[p];
+            auto const start = day_number(period_start(static_cast<CalendarPeriod>(p), date));
+            auto pos = std::lower_bound(table.starts.begin(), table.starts.end(), start);
+            assert(pos != table.starts.end() && *pos == start);
+            auto const idx = pos - table.starts.begin();
+            if (--table.counts[idx] == 0)
+            {
+                table.starts.erase(pos);
+                table.counts.erase(table.counts.begin() + idx);
+                table.sums.erase(table.sums.begin() + idx * dim, table.sums.begin() + (idx + 1) * dim);
+            }
+            else
+            {
+                auto const sums = table.sums.begin() + idx * dim;
+                std::transform(sums, sums + dim, metrics.begin(), sums, std::minus{});
+            }
+        }
+        --d_count;
+    }
+
+    void CalendarRollup::assign(std::span<std::chrono::year_month_day const> dates, std::span<double const> metrics, int dim)
+    {
+        using namespace std::chrono;
+        assert(metrics.size() == dates.size() * static_cast<std::size_t>(dim));
+        clear();
+        if (dates.empty())
+            return;
+        d_dim = dim;
+        d_count = static_cast<int>(dates.size());
+        auto const udim = static_cast<std::size_t>(dim);
+        // Only weeks and months are counted entry by entry; months nest in quarters and
+        // years, so those tables are summed from the month table afterwards. Each table
+        // is filled in its own pass, which keeps the open period's sums at hand. The date
+        // at which that period ends is compared by sort key, so an entry costs no
+        // conversion unless it starts a new period.
+        constexpr int WEEK { static_cast<int>(CalendarPeriod::Week) };
+        constexpr int MONTH { static_cast<int>(CalendarPeriod::Month) };
+        for (int p: { WEEK, MONTH })
+        {
+            auto& table = d_tables[p];
+            auto end = std::numeric_limits<std::int32_t>::min();
+            int* count {};
+            double* sums {};
+            for (std::size_t i {0}; i < dates.size(); ++i)
+            {
+                auto const date = dates[i];
+                if (DayIndex::sort_key(date) >= end)
+                {
+                    auto const start = period_start(static_cast<CalendarPeriod>(p), date);
+                    end = DayIndex::sort_key((p == WEEK) ? year_month_day{ start + weeks{1} } : year_month_day{ start } + months{1});
+                    table.starts.push_back(day_number(start));
+                    table.counts.push_back(0);
+                    table.sums.resize(table.sums.size() + udim);
+                    count = &table.counts.back();
+                    sums = table.sums.data() + table.sums.size() - udim;
+                }
+                ++*count;
+                double const* const row { metrics.data() + i * udim };
+                for (std::size_t col {0}; col < udim; ++col)
+                    sums[col] += row[col];
+            }
+        }
+        auto const& months_table = d_tables[MONTH];
+        for (auto const period: { CalendarPeriod::Quarter, CalendarPeriod::Year })
+        {
+            auto& table = d_tables[static_cast<int>(period)];
+            for (std::size_t i {0}; i < months_table.starts.size(); ++i)
+            {
+                year_month_day const month { sys_days{ days{ months_table.starts[i] } } };
+                auto const start = day_number(period_start(period, month));
+                if (table.starts.empty() || table.starts.back() != start)
+                {
+                    table.starts.push_back(start);
+                    table.counts.push_back(0);
+                    table.sums.resize(table.sums.size() + udim);
+                }
+                table.counts.back() += months_table.counts[i];
+                double* const sums { table.sums.data() + table.sums.size() - udim };
+                for (std::size_t col {0}; col < udim; ++col)
+                    sums[col] += months_table.sums[i * udim + col];
+            }
+        }
+    }
+
+    void CalendarRollup::clear() noexcept
+    {
+        for (auto& table: d_tables)
+        {
+            table.starts.clear();
+            table.counts.clear();
+            table.sums.clear();
+        }
+        d_dim = 0;
+        d_count = 0;
+    }
+} // namespace ewi
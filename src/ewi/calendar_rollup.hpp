@@ -0,0 +1,150 @@
+// calendar_rollup.hpp
+/// Per-period (ISO week, month, quarter, year) entry counts and metric sums, kept up to
+/// date as entries come and go.
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_EWI_CALENDAR_ROLLUP
+#define INCLUDED_EWI_CALENDAR_ROLLUP
+
+#ifndef INCLUDED_STD_ARRAY
+#include <array>
+#define INCLUDED_STD_ARRAY
+#endif
+
+#ifndef INCLUDED_STD_CHRONO
+#include <chrono>
+#define INCLUDED_STD_CHRONO
+#endif
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_CSTDINT
+#include <cstdint>
+#define INCLUDED_STD_CSTDINT
+#endif
+
+#ifndef INCLUDED_STD_MEMORY_RESOURCE
+#include <memory_resource>
+#define INCLUDED_STD_MEMORY_RESOURCE
+#endif
+
+#ifndef INCLUDED_STD_OPTIONAL
+#include <optional>
+#define INCLUDED_STD_OPTIONAL
+#endif
+
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
+#ifndef INCLUDED_STD_VECTOR
+#include <vector>
+#define INCLUDED_STD_VECTOR
+#endif
+
+namespace ewi
+{
+    /// Calendar granularities for rollups. Weeks are ISO weeks (Monday through Sunday);
+    /// quarters start in January, April, July, and October.
+    enum class CalendarPeriod { Week, Month, Quarter, Year };
+
+    /// Metric means per calendar period (see `CalendarRollup::summarize`). Only periods
+    /// containing at least one entry are listed, earliest first.
+    struct PeriodSummaries
+    {
+        std::vector<std::chrono::year_month_day> starts {};  // first day of each period
+        std::vector<int> counts {};  // entries per period
+        std::vector<double> means {};  // row-major; size() x dim
+        int dim {};
+
+        inline auto size() const noexcept -> int { return static_cast<int>(starts.size()); }
+        /// The metric means of the `i`th period. No bounds checking is performed.
+        inline auto mean(int i) const noexcept -> std::span<double const>
+        {
+            return { means.data() + static_cast<std::ptrdiff_t>(i) * dim, static_cast<std::size_t>(dim) };
+        }
+    };
+
+    /// Entry counts and per-metric sums for every ISO week, month, quarter, and year that
+    /// contains an entry.
+    ///
+    /// Each granularity is a table sorted by period, so adding or removing an entry costs
+    /// one `O(metric count)` update per table (plus a binary search if the entry isn't
+    /// the latest). Summarizing reads one row per period and never touches the entries
+    /// themselves.
+    class CalendarRollup
+    {
+        public:
+            // CONSTRUCTORS
+            CalendarRollup() = default;
+            /// Creates an empty rollup whose tables are allocated from `resource`.
+            explicit CalendarRollup(std::pmr::memory_resource* resource)
+                : d_tables{ Table{ resource }, Table{ resource }, Table{ resource }, Table{ resource } } {}
+
+            // ACCESSORS
+
+            /// Query how many metrics each entry holds (0 when empty).
+            inline auto dim() const noexcept -> int { return d_dim; }
+            /// Query how many entries are rolled up.
+            inline auto size() const noexcept -> int { return d_count; }
+            /// Gets the means of each period overlapping `[min, max]`. Periods are
+            /// summarized in full, even if the bounds fall in their middle; a missing
+            /// bound is unbounded.
+            auto summarize(
+                    CalendarPeriod period,
+                    std::optional<std::chrono::year_month_day> min={},
+                    std::optional<std::chrono::year_month_day> max={}
+            ) const -> PeriodSummaries;
+            /// Gets the first day of the period containing `date`.
+            static auto period_start(CalendarPeriod period, std::chrono::year_month_day date) noexcept -> std::chrono::sys_days;
+
+            // MANIPULATORS
+
+            /// Counts an entry in each of its periods. The first entry sets the metric
+            /// count; later ones must match it.
+            void add(std::chrono::year_month_day date, std::span<double const> metrics);
+            /// Replaces the rollup with the entries `dates` (strictly increasing) and their
+            /// `metrics` (row-major; `dates.size()` x `dim`). Sorted dates fill the week
+            /// and month tables in order, and quarters and years are folded from the
+            /// months, so this skips the per-table searches of `add`.
+            void assign(std::span<std::chrono::year_month_day const> dates, std::span<double const> metrics, int dim);
+            /// Un-counts an entry previously added with the same date and metrics.
+            void remove(std::chrono::year_month_day date, std::span<double const> metrics);
+            void clear() noexcept;
+        private:
+            struct Table
+            {
+                Table() = default;
+                explicit Table(std::pmr::memory_resource* resource)
+                    : starts{ resource }, counts{ resource }, sums{ resource } {}
+
+                std::pmr::vector<std::int32_t> starts {};  // day number of each period's first day
+                std::pmr::vector<int> counts {};
+                std::pmr::vector<double> sums {};  // row-major; starts.size() x dim
+            };
+            static constexpr int NUM_PERIODS { 4 };
+
+            std::array<Table, NUM_PERIODS> d_tables {};
+            int d_dim {};
+            int d_count {};
+    };
+} // namespace ewi
+#endif // INCLUDED_EWI_CALENDAR_ROLLUP
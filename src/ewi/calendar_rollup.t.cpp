@@ -0,0 +1,174 @@
+// calendar_rollup.t.cpp
+// CalendarRollup Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "calendar_rollup.hpp"
+//- STL
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+using ewi::CalendarPeriod, ewi::CalendarRollup;
+using namespace std::chrono;
+
+void test_period_start();
+void test_summaries();
+void test_assign();
+
+int main()
+{
+    test_period_start();
+    test_summaries();
+    test_assign();
+}
+//--------------------------------------------------------------------------------------------------
+namespace
+{
+    struct Row
+    {
+        year_month_day date;
+        std::vector<double> metrics;
+    };
+
+    /// Groups the rows by period and compares each group's means with the rollup's.
+    void check(CalendarRollup const& rollup, std::vector<Row> const& rows, CalendarPeriod period,
+            std::optional<year_month_day> min={}, std::optional<year_month_day> max={})
+    {
+        std::map<sys_days, std::vector<Row const*>> groups {};
+        for (auto const& row: rows)
+        {
+            auto const start = CalendarRollup::period_start(period, row.date);
+            if ((!min || start >= CalendarRollup::period_start(period, *min)) && (!max || start <= sys_days{ *max }))
+                groups[start].push_back(&row);
+        }
+        auto const summaries = rollup.summarize(period, min, max);
+        assert(summaries.size() == static_cast<int>(groups.size()));
+        int i {0};
+        for (auto const& [start, members]: groups)
+        {
+            assert(sys_days{ summaries.starts[i] } == start);
+            assert(summaries.counts[i] == static_cast<int>(members.size()));
+            for (int col {0}; col < summaries.dim; ++col)
+            {
+                double sum {};
+                for (auto const* row: members)
+                    sum += row->metrics[col];
+                assert(std::abs(summaries.mean(i)[col] - sum / members.size()) < 1e-9);
+            }
+            ++i;
+        }
+    }
+
+    void check_all(CalendarRollup const& rollup, std::vector<Row> const& rows)
+    {
+        assert(rollup.size() == static_cast<int>(rows.size()));
+        for (auto period: { CalendarPeriod::Week, CalendarPeriod::Month, CalendarPeriod::Quarter, CalendarPeriod::Year })
+        {
+            check(rollup, rows, period);
+            check(rollup, rows, period, 2021y / May / 19d, 2022y / February / 2d);
+            check(rollup, rows, period, std::nullopt, 2020y / March / 31d);
+        }
+    }
+}
+
+void test_period_start()
+{
+    // 2024-01-01 was a Monday; 2023-01-01 a Sunday (ISO week 52 of 2022).
+    assert(CalendarRollup::period_start(CalendarPeriod::Week, 2024y / January / 7d) == sys_days{ 2024y / January / 1d });
+    assert(CalendarRollup::period_start(CalendarPeriod::Week, 2024y / January / 8d) == sys_days{ 2024y / January / 8d });
+    assert(CalendarRollup::period_start(CalendarPeriod::Week, 2023y / January / 1d) == sys_days{ 2022y / December / 26d });
+    assert(CalendarRollup::period_start(CalendarPeriod::Month, 2024y / February / 29d) == sys_days{ 2024y / February / 1d });
+    assert(CalendarRollup::period_start(CalendarPeriod::Quarter, 2024y / June / 30d) == sys_days{ 2024y / April / 1d });
+    assert(CalendarRollup::period_start(CalendarPeriod::Quarter, 2024y / October / 1d) == sys_days{ 2024y / October / 1d });
+    assert(CalendarRollup::period_start(CalendarPeriod::Year, 2024y / December / 31d) == sys_days{ 2024y / January / 1d });
+}
+
+/// Rollups must match a from-scratch grouping through appends, back-dated entries, and
+/// removals.
+void test_summaries()
+{
+    std::mt19937 gen { 19 };
+    std::uniform_int_distribution<int> value { 0, 10 };
+    std::uniform_int_distribution<int> gap { 1, 5 };
+    std::vector<Row> rows {};
+    CalendarRollup rollup {};
+    check_all(rollup, rows);
+
+    for (sys_days day { 2019y / December / 30d }; day < sys_days{ 2023y / January / 1d }; day += days{ gap(gen) })
+    {
+        rows.push_back(Row{ year_month_day{ day }, { double(value(gen)), 0.5 * value(gen) } });
+        rollup.add(rows.back().date, rows.back().metrics);
+    }
+    check_all(rollup, rows);
+
+    // Back-dated entries may open periods before and between existing ones.
+    for (auto date: { 2019y / June / 3d, 2019y / December / 29d })
+    {
+        rows.push_back(Row{ date, { 1., 2. } });
+        rollup.add(date, rows.back().metrics);
+    }
+    check_all(rollup, rows);
+
+    for (std::size_t i {0}; i < rows.size(); i += 3)
+        rollup.remove(rows[i].date, rows[i].metrics);
+    std::vector<Row> kept {};
+    for (std::size_t i {0}; i < rows.size(); ++i)
+        if (i % 3 != 0)
+            kept.push_back(rows[i]);
+    check_all(rollup, kept);
+
+    for (auto const& row: kept)
+        rollup.remove(row.date, row.metrics);
+    assert(rollup.size() == 0 && rollup.dim() == 0);
+    assert(rollup.summarize(CalendarPeriod::Month).size() == 0);
+}
+
+/// A bulk `assign` must summarize exactly like the same rows added one at a time, and then
+/// keep accepting edits.
+void test_assign()
+{
+    std::mt19937 gen { 23 };
+    std::uniform_int_distribution<int> value { 0, 10 };
+    std::uniform_int_distribution<int> gap { 1, 9 };
+    std::vector<Row> rows {};
+    std::vector<year_month_day> dates {};
+    std::vector<double> metrics {};
+    for (sys_days day { 2019y / December / 30d }; day < sys_days{ 2023y / January / 1d }; day += days{ gap(gen) })
+    {
+        rows.push_back(Row{ year_month_day{ day }, { double(value(gen)), 0.5 * value(gen), -1. * value(gen) } });
+        dates.push_back(rows.back().date);
+        metrics.insert(metrics.end(), rows.back().metrics.begin(), rows.back().metrics.end());
+    }
+
+    CalendarRollup rollup {};
+    rollup.add(2018y / May / 5d, std::vector<double>{ 1., 2., 3. });
+    rollup.assign(dates, metrics, 3);
+    check_all(rollup, rows);
+
+    rows.push_back(Row{ 2023y / March / 1d, { 4., 5., 6. } });
+    rollup.add(rows.back().date, rows.back().metrics);
+    rollup.remove(rows.front().date, rows.front().metrics);
+    rows.erase(rows.begin());
+    check_all(rollup, rows);
+
+    rollup.assign({}, {}, 0);
+    assert(rollup.size() == 0 && rollup.dim() == 0);
+    assert(rollup.summarize(CalendarPeriod::Year).size() == 0);
+}
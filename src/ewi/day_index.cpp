@@ -0,0 +1,170 @@
+// day_index.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "day_index.hpp"
+//- STL
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ewi
+{
+    auto DayIndex::find(std::chrono::year_month_day date) const noexcept -> std::optional<int>
+    {
+        // Invalid dates would alias a valid day number (ex. February 30 -> March 1).
+        if (d_count == 0 || !date.ok())
+            return std::nullopt;
+        auto const day = day_number(date);
+        if (d_dense)
+        {
+            // Days before the first one wrap around to large offsets.
+            auto const offset = static_cast<std::uint32_t>(day - d_first);
+            if (offset >= d_slots.size() || d_slots[offset] == NONE)
+                return std::nullopt;
+            return d_slots[offset];
+        }
+        auto pos = d_positions.find(day);
+        if (pos == d_positions.end())
+            return std::nullopt;
+        return pos->second;
+    }
+
+    auto DayIndex::lower_bound(std::chrono::year_month_day date) const noexcept -> int
+    {
+        return search(sort_key(date), 0, d_keys.size());
+    }
+
+    auto DayIndex::upper_bound(std::chrono::year_month_day date) const noexcept -> int
+    {
+        return search(std::int64_t{ sort_key(date) } + 1, 0, d_keys.size());
+    }
+
+    auto DayIndex::lower_bound(std::chrono::year_month_day date, int hint) const noexcept -> int
+    {
+        return gallop(sort_key(date), hint);
+    }
+
+    auto DayIndex::upper_bound(std::chrono::year_month_day date, int hint) const noexcept -> int
+    {
+        return gallop(std::int64_t{ sort_key(date) } + 1, hint);
+    }
+
+    auto DayIndex::search(std::int64_t key, std::size_t lo, std::size_t hi) const noexcept -> int
+    {
+        if (lo == hi)
+            return static_cast<int>(lo);
+        // The answer lies in [base, base + count]. Each step halves the window with a
+        // select rather than a branch, so the loop runs ceil(log2(count)) times whatever
+        // the key.
+        std::int32_t const* base { d_keys.data() + lo };
+        std::size_t count { hi - lo };
+        while (count > 1)
+        {
+            std::size_t const half { count / 2 };
+            base = (base[half - 1] < key) ? base + half : base;
+            count -= half;
+        }
+        return static_cast<int>(base - d_keys.data()) + static_cast<int>(*base < key);
+    }
+
+    auto DayIndex::gallop(std::int64_t key, int hint) const noexcept -> int
+    {
+        auto lo = static_cast<std::size_t>(hint);
+        std::size_t hi { lo };
+        for (std::size_t step {1}; hi < d_keys.size() && d_keys[hi] < key; step *= 2)
+        {
+            lo = hi + 1;
+            hi += step;
+        }
+        return search(key, lo, std::min(hi, d_keys.size()));
+    }
+
+    void DayIndex::assign(std::span<std::chrono::year_month_day const> dates)
+    {
+        clear();
+        if (dates.empty())
+            return;
+        d_first = day_number(dates.front());
+        d_count = static_cast<int>(dates.size());
+        std::int64_t const span_days { std::int64_t{ day_number(dates.back()) } - d_first + 1 };
+        d_dense = fits_dense(span_days, d_count);
+        d_keys.reserve(dates.size());
+        for (auto const& date: dates)
+            d_keys.push_back(sort_key(date));
+        if (d_dense)
+        {
+            d_slots.assign(static_cast<std::size_t>(span_days), NONE);
+            for (int i {0}; i < d_count; ++i)
+                d_slots[static_cast<std::size_t>(day_number(dates[i]) - d_first)] = i;
+        }
+        else
+        {
+            d_positions.reserve(dates.size());
+            for (int i {0}; i < d_count; ++i)
+                d_positions.emplace(day_number(dates[i]), i);
+        }
+    }
+
+    void DayIndex::push_back(std::chrono::year_month_day date)
+    {
+        auto const day = day_number(date);
+        if (d_count == 0)
+        {
+            clear();
+            d_first = day;
+        }
+        d_keys.push_back(sort_key(date));
+        if (d_dense)
+        {
+            std::int64_t const span_days { std::int64_t{ day } - d_first + 1 };
+            if (fits_dense(span_days, d_count + 1))
+            {
+                d_slots.resize(static_cast<std::size_t>(span_days), NONE);
+                d_slots.back() = d_count++;
+                return;
+            }
+            to_sparse();
+        }
+        d_positions.emplace(day, d_count++);
+    }
+
+    void DayIndex::clear() noexcept
+    {
+        d_slots.clear();
+        d_positions.clear();
+        d_keys.clear();
+        d_first = 0;
+        d_count = 0;
+        d_dense = true;
+    }
+
+    void DayIndex::to_sparse()
+    {
+        d_positions.reserve(static_cast<std::size_t>(d_count) + 1);
+        for (std::size_t offset {0}; offset < d_slots.size(); ++offset)
+            if (d_slots[offset] != NONE)
+                d_positions.emplace(d_first + static_cast<std::int32_t>(offset), d_slots[offset]);
+        d_slots.clear();
+        d_slots.shrink_to_fit();
+        d_dense = false;
+    }
+} // namespace ewi
@@ -0,0 +1,148 @@
+// day_index.hpp
+/// Constant-time lookup of a date's position in a sorted column of unique dates.
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_EWI_DAY_INDEX
+#define INCLUDED_EWI_DAY_INDEX
+
+#ifndef INCLUDED_STD_CHRONO
+#include <chrono>
+#define INCLUDED_STD_CHRONO
+#endif
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_CSTDINT
+#include <cstdint>
+#define INCLUDED_STD_CSTDINT
+#endif
+
+#ifndef INCLUDED_STD_MEMORY_RESOURCE
+#include <memory_resource>
+#define INCLUDED_STD_MEMORY_RESOURCE
+#endif
+
+#ifndef INCLUDED_STD_OPTIONAL
+#include <optional>
+#define INCLUDED_STD_OPTIONAL
+#endif
+
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
+#ifndef INCLUDED_STD_UNORDERED_MAP
+#include <unordered_map>
+#define INCLUDED_STD_UNORDERED_MAP
+#endif
+
+#ifndef INCLUDED_STD_VECTOR
+#include <vector>
+#define INCLUDED_STD_VECTOR
+#endif
+
+namespace ewi
+{
+    /// Maps dates to their positions in a sorted column of unique dates.
+    ///
+    /// Survey entries usually fall on a dense daily calendar, so positions are kept in an
+    /// array with one slot per day from the first indexed date to the last. When the
+    /// dates are too spread out for that to pay off (more than `MAX_DAYS_PER_DATE` days
+    /// per date), a hash map from day number to position is used instead. Either way,
+    /// lookups take constant time.
+    ///
+    /// Range queries use a branchless binary search over a packed integer key per date
+    /// (year, month, and day in one `int32`). The key orders dates exactly like
+    /// `year_month_day`'s comparison operators, including for dates that are not `ok()`.
+    class DayIndex
+    {
+        public:
+            static constexpr std::int64_t MAX_DAYS_PER_DATE { 4 };
+
+            // CONSTRUCTORS
+            DayIndex() = default;
+            /// Creates an empty index whose tables are allocated from `resource`.
+            explicit DayIndex(std::pmr::memory_resource* resource)
+                : d_slots{ resource }, d_positions{ resource }, d_keys{ resource } {}
+
+            /// Packs the date's fields into a key that sorts like the date itself. The
+            /// fields are stored in (at most) 16, 8, and 8 bits, so any date fits.
+            static constexpr auto sort_key(std::chrono::year_month_day date) noexcept -> std::int32_t
+            {
+                return static_cast<std::int32_t>(
+                        (static_cast<int>(date.year()) * 256 + static_cast<int>(unsigned{ date.month() })) * 256
+                        + static_cast<int>(unsigned{ date.day() }));
+            }
+
+            // ACCESSORS
+
+            /// Gets the position of the date, if it is indexed.
+            auto find(std::chrono::year_month_day date) const noexcept -> std::optional<int>;
+            /// Gets the position of the first indexed date not earlier than `date` (`size()`
+            /// if there is none).
+            auto lower_bound(std::chrono::year_month_day date) const noexcept -> int;
+            /// Gets the position of the first indexed date later than `date` (`size()` if
+            /// there is none).
+            auto upper_bound(std::chrono::year_month_day date) const noexcept -> int;
+            /// As above, but searches forward from position `hint`, which must not exceed
+            /// the result (ex. the result for an earlier date). Takes `O(log d)` time,
+            /// where `d` is the distance from the hint to the result, so a batch of sorted
+            /// dates is searched in one sweep.
+            auto lower_bound(std::chrono::year_month_day date, int hint) const noexcept -> int;
+            auto upper_bound(std::chrono::year_month_day date, int hint) const noexcept -> int;
+            /// Query if the index uses the per-day array (as opposed to the hash map).
+            inline auto is_dense() const noexcept -> bool { return d_dense; }
+            inline auto size() const noexcept -> int { return d_count; }
+
+            // MANIPULATORS
+
+            /// Indexes the given dates, which must be sorted and unique.
+            void assign(std::span<std::chrono::year_month_day const> dates);
+            /// Indexes a date later than every indexed date at position `size()`.
+            void push_back(std::chrono::year_month_day date);
+            void clear() noexcept;
+        private:
+            static inline auto day_number(std::chrono::year_month_day date) noexcept -> std::int32_t
+            {
+                return static_cast<std::int32_t>(std::chrono::sys_days{ date }.time_since_epoch().count());
+            }
+            /// Gets the position of the first key not less than `key`, which lies within
+            /// positions `[lo, hi]`.
+            auto search(std::int64_t key, std::size_t lo, std::size_t hi) const noexcept -> int;
+            /// As above, but first brackets the position by galloping forward from `hint`.
+            auto gallop(std::int64_t key, int hint) const noexcept -> int;
+            /// Query if a per-day array spanning `span_days` pays off for `count` dates.
+            static constexpr auto fits_dense(std::int64_t span_days, std::int64_t count) noexcept -> bool
+            {
+                return span_days <= MAX_DAYS_PER_DATE * count + 64;
+            }
+            void to_sparse();
+
+            static constexpr std::int32_t NONE { -1 };
+            std::pmr::vector<std::int32_t> d_slots {};  // dense: position per day since d_first
+            std::pmr::unordered_map<std::int32_t, std::int32_t> d_positions {};  // sparse: day -> position
+            std::pmr::vector<std::int32_t> d_keys {};  // sort key per position
+            std::int32_t d_first {};
+            int d_count {};
+            bool d_dense { true };
+    };
+} // namespace ewi
+#endif // INCLUDED_EWI_DAY_INDEX
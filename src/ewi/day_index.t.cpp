@@ -0,0 +1,123 @@
+// day_index.t.cpp
+// DayIndex Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "day_index.hpp"
+//- STL
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <optional>
+#include <random>
+#include <vector>
+
+using ewi::DayIndex;
+using namespace std::chrono;
+
+void test_dense();
+void test_sparse();
+void test_push_back();
+
+int main()
+{
+    test_dense();
+    test_sparse();
+    test_push_back();
+}
+//--------------------------------------------------------------------------------------------------
+namespace
+{
+    /// Checks every day from a month before the first date to a month after the last.
+    void check(DayIndex const& index, std::vector<year_month_day> const& dates)
+    {
+        assert(index.size() == static_cast<int>(dates.size()));
+        std::size_t next {0};
+        for (sys_days day { sys_days{ dates.front() } - days{31} }; day <= sys_days{ dates.back() } + days{31}; day += days{1})
+        {
+            year_month_day const date { day };
+            auto const lower = index.lower_bound(date);
+            auto const upper = index.upper_bound(date);
+            assert(lower == std::ranges::lower_bound(dates, date) - dates.begin());
+            assert(upper == std::ranges::upper_bound(dates, date) - dates.begin());
+            // Hinted searches from anywhere at or before the result agree.
+            for (int hint: { 0, lower / 2, lower })
+                assert(index.lower_bound(date, hint) == lower && index.upper_bound(date, hint) == upper);
+            if (next < dates.size() && sys_days{ dates[next] } == day) {
+                assert(index.find(year_month_day{ day }) == static_cast<int>(next));
+                ++next;
+            } else
+                assert(!index.find(year_month_day{ day }));
+        }
+        assert(next == dates.size());
+    }
+
+    auto gen_dates(int count, int max_gap, unsigned seed) -> std::vector<year_month_day>
+    {
+        std::mt19937 gen { seed };
+        std::uniform_int_distribution<int> gap { 1, max_gap };
+        std::vector<year_month_day> dates {};
+        sys_days day { 2000y / January / 1d };
+        for (int i {0}; i < count; ++i, day += days{ gap(gen) })
+            dates.emplace_back(day);
+        return dates;
+    }
+}
+
+void test_dense()
+{
+    DayIndex index {};
+    assert(!index.find(2024y / January / 1d));
+    auto dates = gen_dates(1000, 3, 1);
+    index.assign(dates);
+    assert(index.is_dense());
+    check(index, dates);
+
+    // Dates that are not ok() are never found, but are still ordered field by field.
+    year_month_day const feb30 { 2000y, February, 30d };
+    assert(!index.find(feb30));
+    assert(index.lower_bound(feb30) == std::ranges::lower_bound(dates, feb30) - dates.begin());
+}
+
+void test_sparse()
+{
+    DayIndex index {};
+    auto dates = gen_dates(300, 30, 2);
+    index.assign(dates);
+    assert(!index.is_dense());
+    check(index, dates);
+}
+
+/// Appending switches to the hash map once the dates spread out.
+void test_push_back()
+{
+    auto dates = gen_dates(200, 2, 3);
+    DayIndex index {};
+    for (auto const& d: dates)
+        index.push_back(d);
+    assert(index.is_dense());
+    check(index, dates);
+
+    for (int i {0}; i < 100; ++i) {
+        dates.emplace_back(sys_days{ dates.back() } + days{ 60 });
+        index.push_back(dates.back());
+    }
+    assert(!index.is_dense());
+    check(index, dates);
+
+    index.clear();
+    assert(!index.find(dates.front()) && index.size() == 0);
+}
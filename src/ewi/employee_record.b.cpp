@@ -0,0 +1,319 @@
+// employee_record.b.cpp
+// EmployeeRecord I/O Benchmark Driver
+//
+// Usage: bench_employee_record [entries_per_record]
+//
+// The export benchmark always runs with 36,500 (a century of daily entries) and 1M
+// entries per record; the arena benchmark loads 2,000 employees of 50 entries per record.
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "employee_record.hpp"
+//- STL
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <utils/string_flattener/string_flattener.hpp>
+
+using namespace ewi;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    /// Builds a Record of daily entries with five metrics and short, multi-line notes.
+    auto gen_record(int num_entries, int seed) -> Record
+    {
+        using namespace std::chrono;
+        sys_days day { 1990y / January / 1d };
+        std::vector<Entry> entries {};
+        entries.reserve(num_entries);
+        for (int i {0}; i < num_entries; ++i, day += days{1})
+        {
+            double x = (i * 7 + seed) % 13;
+            entries.emplace_back(
+                    year_month_day{ day },
+                    (i % 3 == 0) ? std::string("Met with the team.\nFollowed up on tickets.") : std::string(),
+                    std::vector<double> { x, x / 4., 2.5, -x * 1.25, 1e-3 * i }
+            );
+        }
+        return Record(entries);
+    }
+
+    auto gen_employee(int num_entries) -> EmployeeRecord
+    {
+        EmployeeRecord rec { Employee{ EmployeeID{ "B0001" }, "Benchmark User" } };
+        for (int j {0}; j < 3; ++j)
+            rec.add(JobID{ "J" + std::to_string(j) }, WIRecord{ gen_record(num_entries, j), gen_record(num_entries, j + 1) });
+        return rec;
+    }
+
+    /// Builds an employee whose Records look like daily survey responses: hours in
+    /// half-hour steps and small counts that drift slowly, with occasional notes.
+    auto gen_survey_employee(int num_entries) -> EmployeeRecord
+    {
+        using namespace std::chrono;
+        EmployeeRecord rec { Employee{ EmployeeID{ "S0001" }, "Survey User" } };
+        for (int j {0}; j < 3; ++j)
+        {
+            std::vector<Entry> tech {}, pers {};
+            sys_days day { 1990y / January / 1d };
+            for (int i {0}; i < num_entries; ++i, day += days{1})
+            {
+                double hours = 0.5 * ((i * 3 + j) % 9);
+                double cases = (i / 20 + j) % 5;
+                double contacts = (i / 7) % 3;
+                tech.emplace_back(year_month_day{ day }, (i % 7 == 0) ? std::string("Weekly sync.") : std::string(),
+                        std::vector<double> { hours, cases, contacts });
+                pers.emplace_back(year_month_day{ day }, std::string(), std::vector<double> { double((i / 10) % 5 + 1) });
+            }
+            rec.add(JobID{ "J" + std::to_string(j) }, WIRecord{ Record(tech), Record(pers) });
+        }
+        return rec;
+    }
+
+    /// The stream-based import loop `import_record` used before the buffer-based parser.
+    auto import_record_stream(std::string const& path) -> EmployeeRecord
+    {
+        using IO = EmployeeRecordIOUtils;
+        std::ifstream file {path};
+        std::string line {};
+        std::getline(file, line);
+        std::istringstream iss {line};
+        EmployeeRecord output { IO::parse_employee(iss) };
+
+        char check {};
+        while (true)
+        {
+            iss.clear();
+            std::getline(file, line);
+            iss.str(line);
+            if (iss >> check)
+                break;
+            else if (file.eof())
+                return output;
+        }
+        while (!line.empty())
+        {
+            iss.clear();
+            iss.str(line);
+            auto job = IO::parse_job(iss);
+            auto type = IO::parse_recordtype(iss);
+            auto date = IO::parse_date(iss);
+            auto notes = IO::parse_notes(iss);
+            auto metrics = IO::parse_metrics(iss);
+            output.add(job, type, Entry(date, notes, metrics));
+            std::getline(file, line);
+        }
+        return output;
+    }
+
+    /// The stream-based export `export_record` used before formatting with `std::to_chars`.
+    void export_record_stream(EmployeeRecord const& rec, std::string const& path)
+    {
+        using IO = EmployeeRecordIOUtils;
+        std::ofstream file {path, std::ios::binary | std::ios::trunc};
+        file << rec.who().id.formal() << ": " << rec.who().name << "\n\n";
+        for (int j {0}; j < 3; ++j)
+        {
+            JobID const job { "J" + std::to_string(j) };
+            auto const& wi_rec = rec.get(job);
+            for (auto [record, type]: { std::pair<Record const&, RecordType>{ wi_rec.technical, RecordType::Technical },
+                    std::pair<Record const&, RecordType>{ wi_rec.personal, RecordType::Personal } })
+                for (auto const& e: record)
+                {
+                    file << job.formal() << ' ' << IO::get_token(type) << ' ' << std::format("{:%F}", e.date()) << ' ';
+                    for (int i {0}; i < IO::NUM_NOTES_DELIMS; ++i)
+                        file << IO::NOTES_DELIM;
+                    file << utils::StringFlattener::flatten(std::string(e.notes()));
+                    for (int i {0}; i < IO::NUM_NOTES_DELIMS; ++i)
+                        file << IO::NOTES_DELIM;
+                    file << ' ';
+                    for (auto val: e.metrics())
+                        file << val << ' ';
+                    file << "\n";
+                }
+        }
+    }
+
+    template<typename F>
+    auto time_best_of(int runs, F&& f) -> double
+    {
+        double best { 1e300 };
+        for (int i {0}; i < runs; ++i)
+        {
+            auto start = Clock::now();
+            f();
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+}
+
+void bench_text_import(int num_entries);
+void bench_text_export(int num_entries);
+void bench_binary_formats(EmployeeRecord const& rec, std::string const& label);
+void bench_arena_cycles(int num_employees, int num_entries);
+
+int main(int argc, char* argv[])
+{
+    int num_entries { argc > 1 ? std::atoi(argv[1]) : 50'000 };
+    try {
+        bench_text_import(num_entries);
+        for (int n: { 36'500, 1'000'000 })
+            bench_text_export(n);
+        bench_binary_formats(gen_employee(num_entries), "mixed data");
+        bench_binary_formats(gen_survey_employee(num_entries), "survey-like data");
+        bench_arena_cycles(2'000, 50);
+    } catch (cpperrors::Exception const& e) {
+        std::cerr << e.report(true) << "\n";
+        return 1;
+    }
+}
+//--------------------------------------------------------------------------------------------------
+/// Compares the buffer-based `import_record` with the previous stream-based loop, which
+/// it is meant to beat by at least `TARGET_SPEEDUP`. The two alternate, so a change in
+/// machine load affects both of their best times alike.
+void bench_text_import(int num_entries)
+{
+    constexpr double TARGET_SPEEDUP { 10. };
+    constexpr int ROUNDS { 5 };
+    std::string const path { "bench_record.txt" };
+    auto rec = gen_employee(num_entries);
+    EmployeeRecordIOUtils::export_record(rec, path);
+    double mb = static_cast<double>(std::filesystem::file_size(path)) / (1024. * 1024.);
+
+    assert(import_record_stream(path) == EmployeeRecordIOUtils::import_record(path));
+    double stream_s { 1e300 }, buffer_s { 1e300 };
+    for (int i {0}; i < ROUNDS; ++i)
+    {
+        stream_s = std::min(stream_s, time_best_of(1, [&] { import_record_stream(path); }));
+        buffer_s = std::min(buffer_s, time_best_of(3, [&] { EmployeeRecordIOUtils::import_record(path); }));
+    }
+
+    double const speedup { stream_s / buffer_s };
+    std::cout << "<bench_text_import> " << num_entries * 6 << " entries, " << mb << " MiB\n"
+        << "  stream parser: " << stream_s * 1e3 << " ms (" << mb / stream_s << " MiB/s)\n"
+        << "  buffer parser: " << buffer_s * 1e3 << " ms (" << mb / buffer_s << " MiB/s)\n"
+        << "  speedup: " << speedup << "x (target " << TARGET_SPEEDUP << "x: "
+        << (speedup >= TARGET_SPEEDUP ? "met" : "NOT met") << ")\n";
+}
+//--------------------------------------------------------------------------------------------------
+/// Compares `export_record` with the previous stream-based export. Each of the employee's
+/// six Records holds `num_entries` entries.
+void bench_text_export(int num_entries)
+{
+    std::string const path { "bench_export.txt" };
+    auto rec = gen_employee(num_entries);
+    export_record_stream(rec, path);
+    double const stream_mb = static_cast<double>(std::filesystem::file_size(path)) / (1024. * 1024.);
+    double const stream_s = time_best_of(3, [&] { export_record_stream(rec, path); });
+
+    EmployeeRecordIOUtils::export_record(rec, path);
+    assert(EmployeeRecordIOUtils::import_record(path) == rec);
+    double const mb = static_cast<double>(std::filesystem::file_size(path)) / (1024. * 1024.);
+    double const chars_s = time_best_of(3, [&] { EmployeeRecordIOUtils::export_record(rec, path); });
+
+    std::cout << "<bench_text_export> " << num_entries << " entries per record\n"
+        << "  stream export:   " << stream_s * 1e3 << " ms (" << stream_mb / stream_s << " MiB/s, lossy)\n"
+        << "  to_chars export: " << chars_s * 1e3 << " ms (" << mb / chars_s << " MiB/s, "
+        << num_entries * 6 / chars_s / 1e6 << " M entries/s)\n"
+        << "  speedup: " << stream_s / chars_s << "x\n";
+}
+//--------------------------------------------------------------------------------------------------
+/// Compares file size and load time of the text format and both binary encodings.
+void bench_binary_formats(EmployeeRecord const& rec, std::string const& label)
+{
+    std::string const text_path { "bench_record.txt" };
+    std::string const columns_path { "bench_record_columns.ewib" };
+    std::string const packed_path { "bench_record_packed.ewib" };
+    EmployeeRecordIOUtils::export_record(rec, text_path);
+    EmployeeRecordIOUtils::export_record_binary(rec, columns_path, BinaryEncoding::Columns);
+    EmployeeRecordIOUtils::export_record_binary(rec, packed_path, BinaryEncoding::Compressed);
+    assert(EmployeeRecordIOUtils::import_record(packed_path) == rec);
+
+    std::cout << "<bench_binary_formats> " << label << "\n";
+    auto const text_size = static_cast<double>(std::filesystem::file_size(text_path));
+    double const text_s = time_best_of(3, [&] { EmployeeRecordIOUtils::import_record(text_path); });
+    for (auto const& [label, path]: { std::pair{ "text      ", text_path },
+            std::pair{ "columns   ", columns_path }, std::pair{ "compressed", packed_path } })
+    {
+        auto const size = static_cast<double>(std::filesystem::file_size(path));
+        double const secs = time_best_of(3, [&] { EmployeeRecordIOUtils::import_record(path); });
+        std::cout << "  " << label << ": " << size / 1024. << " KiB (" << text_size / size
+            << "x smaller than text), load " << secs * 1e3 << " ms (" << text_s / secs
+            << "x faster than text)\n";
+    }
+}
+//--------------------------------------------------------------------------------------------------
+/// Loads a batch of employee files and then releases it, as a report does, comparing the
+/// default heap with a monotonic arena that is released in one call.
+void bench_arena_cycles(int num_employees, int num_entries)
+{
+    constexpr int CYCLES { 5 };
+    std::cout << "<bench_arena_cycles> " << num_employees << " employees, " << num_entries * 6
+        << " entries each; best of " << CYCLES << " cycles\n";
+
+    auto const rec = gen_employee(num_entries);
+    for (bool binary: { false, true })
+    {
+        std::string const label { binary ? "columns" : "text   " };
+        std::string const path { binary ? "bench_arena.ewib" : "bench_arena.txt" };
+        if (binary)
+            EmployeeRecordIOUtils::export_record_binary(rec, path);
+        else
+            EmployeeRecordIOUtils::export_record(rec, path);
+
+        // Each cycle loads the batch, then destroys it (and releases the arena, if any).
+        auto run = [&](std::pmr::memory_resource* resource, auto&& release) -> std::pair<double, double> {
+            double load_s { 1e300 }, release_s { 1e300 };
+            std::vector<EmployeeRecord> batch {};
+            batch.reserve(num_employees);
+            for (int c {0}; c < CYCLES; ++c)
+            {
+                load_s = std::min(load_s, time_best_of(1, [&] {
+                    for (int i {0}; i < num_employees; ++i)
+                        batch.push_back(EmployeeRecordIOUtils::import_record(path, resource));
+                }));
+                assert(batch.back() == rec);
+                release_s = std::min(release_s, time_best_of(1, [&] { batch.clear(); release(); }));
+            }
+            return { load_s, release_s };
+        };
+        auto const [heap_load, heap_release] = run(std::pmr::get_default_resource(), [] {});
+        std::pmr::monotonic_buffer_resource arena {};
+        auto const [arena_load, arena_release] = run(&arena, [&] { arena.release(); });
+
+        std::cout << "  " << label << " heap:  load " << heap_load * 1e3 << " ms, release "
+            << heap_release * 1e3 << " ms\n"
+            << "  " << label << " arena: load " << arena_load * 1e3 << " ms, release "
+            << arena_release * 1e3 << " ms (cycle " << (heap_load + heap_release) / (arena_load + arena_release)
+            << "x faster)\n";
+    }
+}
@@ -17,84 +17,533 @@
 */
 #include "employee_record.hpp"
 //- STL
+#include <algorithm> // std::ranges::count
+#include <array>
+#include <bit>       // std::endian
 #include <cassert>
+#include <charconv>  // std::{from_chars, to_chars}
 #include <chrono>
-#include <format>
+#include <cstdint>
+#include <cstring>   // std::memcpy
+#include <filesystem>
 #include <fstream>
 #include <ios>       // std::{skipws, noskipws}
+#include <iterator>  // std::{size, make_move_iterator}
+#include <limits>
 #include <map>
+#include <memory_resource>
+#include <optional>
 #include <sstream>
 #include <ranges>    // std::views::keys
+#include <span>
 #include <stdexcept> // for std::out_of_range
+#include <system_error>
 #include <string>
+#include <string_view>
 #include <utility>   // std::pair
 #include <vector>
 //- Third-party
 #include <cpperrors>
 //- In-house
+#include <utils/iso_date.hpp>
+#include <utils/mapped_file.hpp>
+#include <utils/timeseries_codec.hpp>
 #include <utils/string_flattener/string_flattener.hpp>
 
 
 using cpperrors::Exception, cpperrors::TypedException;
 using std::istringstream;
 using utils::StringFlattener;
+
+// Binary format helpers
+namespace
+{
+    static_assert(
+            std::endian::native == std::endian::little,
+            "The binary record format is defined as little-endian."
+    );
+    constexpr std::size_t BINARY_ALIGNMENT { 8 };
+
+    /// Appends fixed-width values to an in-memory image of a binary record file.
+    class BinaryWriter
+    {
+        public:
+            template<typename T>
+            void put(T const& val)
+            {
+                auto const* bytes = reinterpret_cast<char const*>(&val);
+                d_buf.append(bytes, sizeof(T));
+            }
+            template<typename T>
+            void put_array(T const* data, std::size_t count)
+            {
+                d_buf.append(reinterpret_cast<char const*>(data), count * sizeof(T));
+            }
+            void put_string(std::string_view str)
+            {
+                put(static_cast<std::uint32_t>(str.size()));
+                d_buf.append(str);
+            }
+            /// Zero-pads the image so the next column starts on an aligned boundary.
+            void align() { d_buf.append((BINARY_ALIGNMENT - d_buf.size() % BINARY_ALIGNMENT) % BINARY_ALIGNMENT, '\0'); }
+            inline auto str() const -> std::string const& { return d_buf; }
+        private:
+            std::string d_buf {};
+    };
+
+    /// Reads fixed-width values from a mapped binary record file. Every read is bounds
+    /// checked, so a truncated file results in an exception instead of a bad read.
+    class BinaryReader
+    {
+        public:
+            BinaryReader(std::string_view data) : d_data{ data } {}
+
+            template<typename T>
+            auto get() -> T
+            {
+                T val;
+                std::memcpy(&val, take(sizeof(T)), sizeof(T));
+                return val;
+            }
+            /// Copies `count` values of a column into `out` with a single memcpy.
+            template<typename T>
+            void get_array(T* out, std::size_t count)
+            {
+                if (count)
+                    std::memcpy(out, take(count * sizeof(T)), count * sizeof(T));
+            }
+            auto get_view(std::size_t count) -> std::string_view { return { take(count), count }; }
+            auto get_string() -> std::string
+            {
+                auto len = get<std::uint32_t>();
+                return std::string(get_view(len));
+            }
+            void align() { take((BINARY_ALIGNMENT - d_pos % BINARY_ALIGNMENT) % BINARY_ALIGNMENT); }
+            /// Query the number of bytes left to read.
+            auto remaining() const noexcept -> std::size_t { return d_data.size() - d_pos; }
+        private:
+            auto take(std::size_t count) -> char const*
+            {
+                if (count > d_data.size() - d_pos)
+                    throw Exception("Incorrect format: binary record file is truncated.");
+                char const* ptr = d_data.data() + d_pos;
+                d_pos += count;
+                return ptr;
+            }
+            std::string_view d_data;
+            std::size_t d_pos {};
+    };
+
+    /// Removes the first line from `remaining` and returns it without its line ending.
+    inline auto next_line(std::string_view& remaining) -> std::string_view
+    {
+        auto end = remaining.find('\n');
+        std::string_view line = remaining.substr(0, end);
+        remaining.remove_prefix(end == std::string_view::npos ? remaining.size() : end + 1);
+        // Tolerate files written with CRLF line endings.
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        return line;
+    }
+
+    constexpr auto is_space(char c) noexcept -> bool
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+    }
+
+    // The leading tokens of an Entry line. These back the public `parse_*` functions and
+    // are declared inline so the import loop runs without a call per token.
+
+    /// Removes the whitespace that starts `line`.
+    inline void skip_spaces(std::string_view& line) noexcept
+    {
+        std::size_t start {0};
+        while (start < line.size() && is_space(line[start]))
+            ++start;
+        line.remove_prefix(start);
+    }
+
+    inline auto take_job(std::string_view& line) noexcept -> std::string_view
+    {
+        skip_spaces(line);
+        std::size_t end {0};
+        while (end < line.size() && line[end] != ' ' && line[end] != '\t')
+            ++end;
+        std::string_view job = line.substr(0, end);
+        line.remove_prefix(end);
+        return job;
+    }
+
+    inline auto take_recordtype(std::string_view& line) -> ewi::RecordType
+    {
+        using IO = ewi::EmployeeRecordIOUtils;
+        skip_spaces(line);
+        if (line.empty())
+            throw Exception("Incorrect RecordType value.");
+        char type = line.front();
+        line.remove_prefix(1);
+        switch (type) {
+            case IO::TECHINCAL_TKN:
+                return ewi::RecordType::Technical;
+            case IO::PERSONAL_TKN:
+                return ewi::RecordType::Personal;
+            default:
+                throw Exception("Incorrect RecordType value.");
+        }
+    }
+
+    /// Parses a date of non-canonical widths (ex. 2024-1-5), as accepted by `%Y-%m-%d`.
+    auto take_loose_date(std::string_view& line) -> std::chrono::year_month_day
+    {
+        int y {};
+        unsigned m {};
+        unsigned d {};
+        char const* const end = line.data() + line.size();
+        auto res = std::from_chars(line.data(), end, y);
+        if (res.ec != std::errc{} || res.ptr == end || *res.ptr != '-')
+            throw Exception("Incorrect format: Could not read date.");
+        res = std::from_chars(res.ptr + 1, end, m);
+        if (res.ec != std::errc{} || res.ptr == end || *res.ptr != '-')
+            throw Exception("Incorrect format: Could not read date.");
+        res = std::from_chars(res.ptr + 1, end, d);
+        if (res.ec != std::errc{})
+            throw Exception("Incorrect format: Could not read date.");
+        line.remove_prefix(static_cast<std::size_t>(res.ptr - line.data()));
+
+        std::chrono::year_month_day date { std::chrono::year{y}, std::chrono::month{m}, std::chrono::day{d} };
+        if (!date.ok())
+            throw Exception("Incorrect format: Could not read date.");
+        return date;
+    }
+
+    inline auto take_date(std::string_view& line) -> std::chrono::year_month_day
+    {
+        skip_spaces(line);
+        if (auto date = utils::IsoDate::parse(line.substr(0, utils::IsoDate::WIDTH));
+                date && (line.size() == utils::IsoDate::WIDTH || line[utils::IsoDate::WIDTH] == ' ' || line[utils::IsoDate::WIDTH] == '\t'))
+        {
+            line.remove_prefix(utils::IsoDate::WIDTH);
+            return *date;
+        }
+        return take_loose_date(line);
+    }
+
+    /// Parses the number at `first` with `from_chars`, advancing `p` past it.
+    auto parse_metric_fallback(char const* first, char const*& p, char const* last) -> double
+    {
+        double val {};
+        auto res = std::from_chars(first, last, val);
+        if (res.ec != std::errc{})
+            throw Exception("Could not get user metric data.");
+        p = res.ptr;
+        return val;
+    }
+
+    /// Appends the whitespace-separated numbers of `line` to `out`.
+    ///
+    /// Plain decimals of up to 15 significant digits (which is all `export_record`
+    /// writes for typical survey data) are parsed exactly without `from_chars`: the
+    /// digits form an integer that is exact as a double, as is the power of ten it is
+    /// divided by, so the one correctly rounded division gives the correctly rounded
+    /// result. Anything else (exponents, `inf`, long mantissas) goes to `from_chars`.
+    /// The parse is written out in the loop rather than called per number, as this runs
+    /// for every metric of a file.
+    template<typename Vector>
+    void append_metrics(std::string_view line, Vector& out)
+    {
+        static constexpr double POW10[] { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+            1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+        constexpr std::size_t MAX_DIGITS { std::size(POW10) - 1 };
+
+        char const* p = line.data();
+        char const* const last = p + line.size();
+        while (p != last)
+        {
+            char const* const first = p;
+            bool const negative { *p == '-' };
+            p += negative;
+            std::uint64_t mantissa {};
+            std::size_t digits {};
+            std::size_t frac_digits {};
+            for (; p != last && *p >= '0' && *p <= '9'; ++p, ++digits)
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+            if (p != last && *p == '.')
+                for (++p; p != last && *p >= '0' && *p <= '9'; ++p, ++digits, ++frac_digits)
+                    mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+
+            double val {};
+            if (digits > 0 && digits <= MAX_DIGITS && (p == last || (*p != 'e' && *p != 'E')))
+            {
+                val = static_cast<double>(mantissa) / POW10[frac_digits];
+                val = negative ? -val : val;
+            }
+            else
+                val = parse_metric_fallback(first, p, last);
+            out.push_back(val);
+            while (p != last && is_space(*p))
+                ++p;
+        }
+    }
+
+    /// Parses the Entry lines stored at `ranges` of a text record file into a Record
+    /// allocated from `resource`. Every line must belong to the given job and RecordType;
+    /// anything else means the file changed since its index was built.
+    auto read_record_ranges(
+            std::ifstream& file,
+            std::vector<ewi::ByteRange> const& ranges,
+            std::string_view job,
+            ewi::RecordType type,
+            std::pmr::memory_resource* resource
+    ) -> ewi::Record
+    {
+        using IO = ewi::EmployeeRecordIOUtils;
+        std::vector<ewi::Entry> entries {};
+        std::string buffer {};
+        for (auto const& range: ranges)
+        {
+            buffer.resize(range.length);
+            file.seekg(static_cast<std::streamoff>(range.offset));
+            if (!file.read(buffer.data(), static_cast<std::streamsize>(range.length)))
+                throw Exception("Could not read record file; its index is out of date.");
+
+            std::string_view remaining { buffer };
+            while (!remaining.empty())
+            {
+                auto line = next_line(remaining);
+                if (IO::parse_job(line) != job || IO::parse_recordtype(line) != type)
+                    throw Exception("Incorrect format: record file does not match its index.");
+                auto date = IO::parse_date(line);
+                auto notes = IO::parse_notes(line);
+                auto metrics = IO::parse_metrics(line);
+                entries.emplace_back(date, std::move(notes), std::move(metrics));
+            }
+        }
+        return ewi::Record(entries, resource);
+    }
+
+    /// Appends `val` as an LEB128 varint.
+    void put_varint(std::string& out, std::uint64_t val)
+    {
+        while (val >= 0x80)
+        {
+            out.push_back(static_cast<char>((val & 0x7F) | 0x80));
+            val >>= 7;
+        }
+        out.push_back(static_cast<char>(val));
+    }
+
+    auto get_varint(std::string_view& in) -> std::uint64_t
+    {
+        std::uint64_t val {};
+        for (int shift {0}; shift < 64; shift += 7)
+        {
+            if (in.empty())
+                throw Exception("Incorrect format: binary record file is truncated.");
+            auto const byte = static_cast<unsigned char>(in.front());
+            in.remove_prefix(1);
+            val |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return val;
+        }
+        throw Exception("Incorrect format: corrupt varint.");
+    }
+
+    /// Writes one Record as its date, metric, and notes columns.
+    void write_record_columns(BinaryWriter& out, ewi::Record const& rec, ewi::BinaryEncoding encoding)
+    {
+        auto const count = static_cast<std::uint32_t>(rec.size());
+        auto const dim = static_cast<std::uint32_t>(rec.metric_dim());
+        out.put(count);
+        out.put(dim);
+        out.put(static_cast<std::uint32_t>(encoding));
+        out.align();
+
+        std::vector<std::int32_t> days {};
+        std::vector<double> metrics {};
+        std::vector<std::uint32_t> note_offsets { 0 };
+        std::string notes {};
+        days.reserve(count);
+        metrics.reserve(static_cast<std::size_t>(count) * dim);
+        note_offsets.reserve(count + 1);
+        for (ewi::EntryView e: rec) {
+            days.push_back(std::chrono::sys_days{ e.date() }.time_since_epoch().count());
+            metrics.insert(metrics.end(), e.metrics().begin(), e.metrics().end());
+            notes.append(e.notes());
+            note_offsets.push_back(static_cast<std::uint32_t>(notes.size()));
+        }
+
+        if (encoding == ewi::BinaryEncoding::Compressed)
+        {
+            // One bit stream holds the dates followed by each metric column.
+            utils::BitWriter bits {};
+            utils::TimeSeriesCodec::encode_timestamps(days, bits);
+            if (count > 0)  // Otherwise there are no columns to offset into.
+                for (std::uint32_t col {0}; col < dim; ++col)
+                    utils::TimeSeriesCodec::encode_values(std::span(metrics).subspan(col), dim, bits);
+            out.put_string(bits.finish());
+
+            std::string lengths {};
+            for (std::size_t i {0}; i < count; ++i)
+                put_varint(lengths, note_offsets[i + 1] - note_offsets[i]);
+            out.put_string(lengths);
+            out.put_array(notes.data(), notes.size());
+            out.align();
+            return;
+        }
+        out.put_array(days.data(), days.size());
+        out.align();
+        out.put_array(metrics.data(), metrics.size());
+        out.put_array(note_offsets.data(), note_offsets.size());
+        out.put_array(notes.data(), notes.size());
+        out.align();
+    }
+
+    /// Reads one Record written by `write_record_columns` in a file of the given version,
+    /// allocating it from `resource`.
+    auto read_record_columns(BinaryReader& in, std::uint32_t version, std::pmr::memory_resource* resource) -> ewi::Record
+    {
+        auto const count = in.get<std::uint32_t>();
+        auto const dim = in.get<std::uint32_t>();
+        auto encoding { ewi::BinaryEncoding::Columns };
+        if (version >= 2)
+        {
+            encoding = static_cast<ewi::BinaryEncoding>(in.get<std::uint32_t>());
+            in.align();
+        }
+
+        // The header is untrusted, so check that the columns it describes fit in the
+        // file before sizing them from it.
+        std::uint64_t const cells { std::uint64_t{ count } * dim };
+        std::string_view packed {};
+        if (encoding == ewi::BinaryEncoding::Columns)
+        {
+            auto const left = in.remaining();
+            if (cells > left / sizeof(double)
+                    || cells * sizeof(double) + (2 * std::uint64_t{ count } + 1) * sizeof(std::uint32_t) > left)
+                throw Exception("Incorrect format: binary record file is truncated.");
+        }
+        else if (encoding == ewi::BinaryEncoding::Compressed)
+        {
+            // Every date and value takes at least one bit of the packed block, and an
+            // empty Record packs to nothing.
+            packed = in.get_view(in.get<std::uint32_t>());
+            auto const bits = std::uint64_t{ packed.size() } * 8;
+            if (count > bits || cells > bits - count || (count == 0 && !packed.empty()))
+                throw Exception("Incorrect format: corrupt compressed record.");
+        }
+
+        std::vector<std::int32_t> days(count);
+        std::vector<double> metrics(static_cast<std::size_t>(cells));
+        std::vector<std::uint32_t> note_offsets(static_cast<std::size_t>(count) + 1);
+        std::string_view notes {};
+        switch (encoding)
+        {
+            case ewi::BinaryEncoding::Columns:
+                in.get_array(days.data(), days.size());
+                in.align();
+                in.get_array(metrics.data(), metrics.size());
+                in.get_array(note_offsets.data(), note_offsets.size());
+                notes = in.get_view(note_offsets.back());
+                in.align();
+                break;
+            case ewi::BinaryEncoding::Compressed:
+            {
+                utils::BitReader bits { packed };
+                utils::TimeSeriesCodec::decode_timestamps(bits, days);
+                if (count > 0)
+                    for (std::uint32_t col {0}; col < dim; ++col)
+                        utils::TimeSeriesCodec::decode_values(bits, std::span(metrics).subspan(col), dim);
+
+                auto lengths = in.get_view(in.get<std::uint32_t>());
+                for (std::size_t i {0}; i < count; ++i)
+                {
+                    auto const len = get_varint(lengths);
+                    if (len > UINT32_MAX - note_offsets[i])
+                        throw Exception("Incorrect format: corrupt note lengths.");
+                    note_offsets[i + 1] = note_offsets[i] + static_cast<std::uint32_t>(len);
+                }
+                notes = in.get_view(note_offsets.back());
+                in.align();
+                break;
+            }
+            default:
+                throw Exception("Incorrect format: unknown record encoding.");
+        }
+
+        std::vector<ewi::Entry> entries {};
+        entries.reserve(count);
+        for (std::size_t i {0}; i < count; ++i) {
+            if (note_offsets[i] > note_offsets[i + 1])
+                throw Exception("Incorrect format: corrupt notes offset table.");
+            entries.emplace_back(
+                    std::chrono::year_month_day{ std::chrono::sys_days{ std::chrono::days{ days[i] } } },
+                    std::string(notes.substr(note_offsets[i], note_offsets[i + 1] - note_offsets[i])),
+                    std::span<double const>(metrics).subspan(i * dim, dim)
+            );
+        }
+        return ewi::Record(entries, resource);
+    }
+}
+
 namespace ewi
 {
     /* EmployeeRecord */
-    void EmployeeRecord::add(JobID job, WIRecord const& wi_rec)
+    void EmployeeRecord::add(JobID job, WIRecord wi_rec)
     { 
-        if (!d_data.insert({job, wi_rec}).second)
+        if (!d_data.try_emplace(std::move(job), std::move(wi_rec)).second)
             throw Exception("Job already exists for this record.");
     }
 
     void EmployeeRecord::add(JobID job, RecordType type, Entry const& e)
     {
-        if (auto test = d_data.find(job); test != d_data.end())
-        {
-            // Try to add the Entry to the specified Record.
-            auto& wi_rec = get_mut(job);
+        emplace(std::move(job), type, e.date(), e.notes(), e.metrics());
+    }
+
+    void EmployeeRecord::emplace(
+            JobID job,
+            RecordType type,
+            std::chrono::year_month_day date,
+            std::string_view notes,
+            std::span<double const> metrics
+    )
+    {
+        auto select = [type](WIRecord& wi_rec) -> Record& {
             switch (type) 
             {
                 case RecordType::Technical:
-                    wi_rec.technical.add(e);
-                    break;
+                    return wi_rec.technical;
                 case RecordType::Personal:
-                    wi_rec.personal.add(e);
-                    break;
+                    return wi_rec.personal;
                 default:
                     throw Exception("Unknown RecordType");
             }    
+        };
+        if (d_data.contains(job))
+        {
+            // Try to add the Entry to the specified Record.
+            select(get_mut(job)).emplace(date, notes, metrics);
         }
         else
         {
             // Key doesn't exist, so create record.
-            WIRecord wi_rec {};
-            switch (type)
-            {
-                case RecordType::Technical:
-                    wi_rec.technical.add(e);  // should never fail.
-                    break;
-                case RecordType::Personal:
-                    wi_rec.personal.add(e);
-                    break;
-                default:
-                    throw Exception("Unknown RecordType");
-            }
-            add(job, wi_rec);
+            auto wi_rec = blank();
+            select(wi_rec).emplace(date, notes, metrics);  // should never fail.
+            add(std::move(job), std::move(wi_rec));
         }
     }
     
     auto EmployeeRecord::get_mut(JobID job) -> WIRecord& 
     {
-        try {
-            return d_data[job];
-        } catch (std::out_of_range const& e) {
-            throw Exception(e.what());
-        }
+        load(job);
+        auto found = d_data.find(job);
+        if (found == d_data.end())
+            found = d_data.emplace(std::move(job), blank()).first;
+        return found->second;
     }
     
     auto EmployeeRecord::get(JobID job) const -> WIRecord const& 
     {
+        load(job);
         try {
             return d_data.at(job);
         } catch (std::out_of_range const& e) {
@@ -107,130 +556,602 @@ namespace ewi
         return std::views::keys(d_data);
     }
 
+    auto EmployeeRecord::blank() const -> WIRecord
+    {
+        return WIRecord{ Record(resource()), Record(resource()) };
+    }
+
+    void EmployeeRecord::load(JobID const& job) const
+    {
+        auto pending = d_pending.find(job);
+        if (pending == d_pending.end())
+            return;
+        std::ifstream file {d_source.c_str(), std::ios::binary};
+        if (!file.is_open())
+            throw Exception("Could not open file: " + std::string(d_source));
+
+        auto const& ranges = d_segments.at(job);
+        WIRecord wi_rec {
+            read_record_ranges(file, ranges.technical, job.formal(), RecordType::Technical, resource()),
+            read_record_ranges(file, ranges.personal, job.formal(), RecordType::Personal, resource())
+        };
+        d_data[job] = std::move(wi_rec);
+        d_pending.erase(pending);
+        mark_clean(job);
+    }
+
+    void EmployeeRecord::load_all() const
+    {
+        while (!d_pending.empty())
+        {
+            JobID job { *d_pending.begin() };
+            load(job);
+        }
+    }
+
+    auto EmployeeRecord::is_dirty() const -> bool
+    {
+        return std::ranges::any_of(jobs(), [this](JobID const& job) { return is_dirty(job); });
+    }
+
+    auto EmployeeRecord::is_dirty(JobID const& job) const -> bool
+    {
+        if (d_pending.contains(job))
+            return false;
+        auto clean = d_clean.find(job);
+        auto current = d_data.find(job);
+        if (clean == d_clean.end() || current == d_data.end())
+            return true;
+        auto const& [technical, personal] = clean->second;
+        return current->second.technical.version() != technical
+            || current->second.personal.version() != personal;
+    }
+
+    auto EmployeeRecord::dirty_jobs() const -> std::vector<JobID>
+    {
+        std::vector<JobID> dirty {};
+        for (auto const& job: jobs())
+            if (is_dirty(job))
+                dirty.push_back(job);
+        return dirty;
+    }
+
+    void EmployeeRecord::mark_clean(JobID const& job) const
+    {
+        auto const& wi_rec = d_data.at(job);
+        d_clean[job] = { wi_rec.technical.version(), wi_rec.personal.version() };
+    }
+
+    void EmployeeRecord::set_source(std::string path, std::uint64_t size, std::map<JobID, JobRanges> segments)
+    {
+        d_source = std::move(path);
+        d_source_size = size;
+        d_segments.clear();
+        d_segments.insert(std::make_move_iterator(segments.begin()), std::make_move_iterator(segments.end()));
+        d_clean.clear();
+        for (auto const& job: jobs())
+            if (!d_pending.contains(job))
+                mark_clean(job);
+    }
+
 
     /* EmployeeRecordIOUtils */
     /* EXPORT Functions */
     
-    void EmployeeRecordIOUtils::export_entry(
-            std::ostream &os,
-            Entry const& e,
+    void EmployeeRecordIOUtils::format_entry(
+            std::string& buf,
+            EntryView e,
             JobID const& job,
             RecordType type
     )
     {
-        os << job.formal() << ' ' << get_token(type) << ' '
-            << std::format("{:%F}", e.date()) << ' ';
+        buf += job.formal();
+        buf += ' ';
+        buf += get_token(type);
+        buf += ' ';
+        if (utils::IsoDate::is_formattable(e.date()))
+        {
+            auto const pos = buf.size();
+            buf.resize(pos + utils::IsoDate::WIDTH);
+            utils::IsoDate::format(e.date(), buf.data() + pos);
+        }
+        else
+            buf += utils::IsoDate::to_string(e.date());
+        buf += ' ';
         // Export Notes
-        for (int i {0}; i < EmployeeRecordIOUtils::NUM_NOTES_DELIMS; ++i)
-            os << EmployeeRecordIOUtils::NOTES_DELIM;
-        os << StringFlattener::flatten(e.notes());
-        for (int i {0}; i < EmployeeRecordIOUtils::NUM_NOTES_DELIMS; ++i)
-            os << EmployeeRecordIOUtils::NOTES_DELIM;
-        os << ' ';
-        // Export metrics
+        buf.append(EmployeeRecordIOUtils::NUM_NOTES_DELIMS, EmployeeRecordIOUtils::NOTES_DELIM);
+        StringFlattener::append_flattened(buf, e.notes());
+        buf.append(EmployeeRecordIOUtils::NUM_NOTES_DELIMS, EmployeeRecordIOUtils::NOTES_DELIM);
+        buf += ' ';
+        // Export metrics in their shortest round-trip form.
+        std::array<char, MAX_METRIC_CHARS> num {};
         for (auto val: e.metrics())
-            os << val << ' ';
+        {
+            auto res = std::to_chars(num.data(), num.data() + num.size(), val);
+            buf.append(num.data(), res.ptr);
+            buf += ' ';
+        }
+        buf += '\n';
+    }
 
-        os << "\n";
+    void EmployeeRecordIOUtils::export_entry(
+            std::ostream &os,
+            EntryView e,
+            JobID const& job,
+            RecordType type
+    )
+    {
+        std::string line {};
+        format_entry(line, e, job, type);
+        os.write(line.data(), static_cast<std::streamsize>(line.size()));
     }
 
-    void EmployeeRecordIOUtils::export_record(EmployeeRecord const& rec, std::string const& path)
+    void EmployeeRecordIOUtils::export_record(EmployeeRecord const& rec, std::string const& path, bool write_index)
     {
-        std::ofstream file {path, std::ios::trunc};
+        // Lazily-opened records may be reading from this very file.
+        rec.load_all();
+        std::ofstream file {path, std::ios::binary | std::ios::trunc};
         if (!file.is_open())
             throw Exception("Could not open file.");
 
         // Write Employee information
         auto person = rec.who();
-        file << person.id.formal() << ": " << person.name << "\n";
-        file << "\n";
+        std::string buffer { person.id.formal() + ": " + person.name + "\n\n" };
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::uint64_t offset { buffer.size() };
 
-        // Write out all Job WIRecords
+        // Write out all Job WIRecords, noting where each Record's lines land.
+        RecordIndex index {};
         using type_pair = std::pair<Record const&, RecordType>;
         for (auto const& job: rec.jobs())
         {
             auto const& wi_rec = rec.get(job);
+            auto& ranges = index.jobs[job];
             // Write both technical and personal records to file
             for (auto [record, rec_type]: {
                     type_pair(wi_rec.technical, RecordType::Technical),
                     type_pair(wi_rec.personal, RecordType::Personal) 
                  }
             ) 
+            {
+                // Each Record is formatted into the reused buffer and written at once.
+                buffer.clear();
                 for (auto const& e: record)
-                    export_entry(file, e, job, rec_type);
+                    format_entry(buffer, e, job, rec_type);
+                if (!buffer.empty())
+                    (rec_type == RecordType::Technical ? ranges.technical : ranges.personal)
+                        .push_back(ByteRange{ offset, buffer.size() });
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                offset += buffer.size();
+            }
+        }
+        file.flush();
+        if (!file)
+            throw Exception("Could not write record file.");
+        index.file_size = offset;
+        if (write_index)
+            export_index(index, path);
+        else
+        {
+            std::error_code ec {};
+            std::filesystem::remove(index_path(path), ec);
+        }
+    }
+
+    auto EmployeeRecordIOUtils::export_record_incremental(EmployeeRecord& rec, std::string const& path) -> bool
+    {
+        namespace fs = std::filesystem;
+        std::error_code ec {};
+        bool const has_source { !rec.d_source.empty() && fs::exists(rec.d_source, ec) };
+        auto const source_size = has_source ? static_cast<std::uint64_t>(fs::file_size(rec.d_source, ec)) : 0;
+        bool const same_file { has_source && fs::exists(path, ec) && fs::equivalent(rec.d_source, path, ec) };
+        if (same_file && source_size == rec.d_source_size && !rec.is_dirty())
+            return false;
+
+        // Clean segments can be copied as long as the source has only been appended to
+        // (ex. by journal compaction) since they were located.
+        bool const can_splice { has_source && source_size >= rec.d_source_size && !rec.d_segments.empty() };
+        if (!can_splice)
+            rec.load_all();
+        std::optional<utils::MappedFile> source {};
+        if (can_splice)
+            source.emplace(std::string(rec.d_source));
+
+        auto const& person = rec.who();
+        std::string out { person.id.formal() + ": " + person.name + "\n\n" };
+
+        RecordIndex index {};
+        for (auto const& job: rec.jobs())
+        {
+            auto& ranges = index.jobs[job];
+            auto segment = rec.d_segments.find(job);
+            bool const copy { can_splice && !rec.is_dirty(job) && segment != rec.d_segments.end() };
+            for (auto rec_type: { RecordType::Technical, RecordType::Personal })
+            {
+                std::uint64_t const start { out.size() };
+                if (copy)
+                {
+                    auto const& old_ranges = (rec_type == RecordType::Technical) ? segment->second.technical : segment->second.personal;
+                    for (auto const& r: old_ranges)
+                    {
+                        if (r.offset + r.length > source->size())
+                            throw Exception("Record file does not match its index: " + std::string(rec.d_source));
+                        auto bytes = source->view().substr(r.offset, r.length);
+                        auto check = bytes;
+                        if (parse_job(check) != job.formal())
+                            throw Exception("Record file does not match its index: " + std::string(rec.d_source));
+                        out.append(bytes);
+                    }
+                }
+                else
+                {
+                    auto const& wi_rec = rec.get(job);
+                    for (auto const& e: (rec_type == RecordType::Technical) ? wi_rec.technical : wi_rec.personal)
+                        format_entry(out, e, job, rec_type);
+                }
+                std::uint64_t const end { out.size() };
+                if (end > start)
+                    (rec_type == RecordType::Technical ? ranges.technical : ranges.personal)
+                        .push_back(ByteRange{ start, end - start });
+            }
+        }
+        source.reset();  // Release the mapping so the file can be replaced.
+
+        auto const& contents = out;
+        std::string const tmp_path { path + ".part" };
+        {
+            std::ofstream file {tmp_path, std::ios::binary | std::ios::trunc};
+            if (!file.is_open())
+                throw Exception("Could not open file: " + tmp_path);
+            file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            file.flush();
+            if (!file)
+                throw Exception("Could not write file: " + tmp_path);
         }
+        fs::rename(tmp_path, path, ec);
+        if (ec)
+            throw Exception("Could not replace file: " + path);
+
+        index.file_size = contents.size();
+        export_index(index, path);
+        rec.set_source(path, index.file_size, std::move(index.jobs));
+        return true;
+    }
+
+    void EmployeeRecordIOUtils::export_record_binary(
+            EmployeeRecord const& rec,
+            std::string const& path,
+            BinaryEncoding encoding
+    )
+    {
+        BinaryWriter out {};
+        out.put_array(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        out.put(BINARY_VERSION);
+
+        auto const& person = rec.who();
+        out.put_string(person.id.formal());
+        out.put_string(person.name);
+
+        auto jobs = rec.jobs();
+        out.put(static_cast<std::uint32_t>(std::ranges::distance(jobs)));
+        out.align();
+        for (auto const& job: jobs)
+        {
+            auto const& wi_rec = rec.get(job);
+            out.put_string(job.formal());
+            out.align();
+            write_record_columns(out, wi_rec.technical, encoding);
+            write_record_columns(out, wi_rec.personal, encoding);
+        }
+
+        std::ofstream file {path, std::ios::binary | std::ios::trunc};
+        if (!file.is_open())
+            throw Exception("Could not open file.");
+        file.write(out.str().data(), static_cast<std::streamsize>(out.str().size()));
         file.flush();
+        if (!file)
+            throw Exception("Could not write binary record file.");
     }
 
     /* IMPORT Functions */
 
-    auto EmployeeRecordIOUtils::import_record(std::string const& path) -> EmployeeRecord
+    auto EmployeeRecordIOUtils::is_binary_record(std::string const& path) -> bool
+    {
+        std::ifstream file {path, std::ios::binary};
+        char magic[sizeof(BINARY_MAGIC)] {};
+        if (!file.read(magic, sizeof(magic)))
+            return false;
+        return std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+    }
+
+    auto EmployeeRecordIOUtils::import_record_binary(
+            std::string const& path,
+            std::pmr::memory_resource* resource
+    ) -> EmployeeRecord
     {
-        std::ifstream file {path};
-        if (!file.is_open()) {
-            std::ostringstream err_msg {};
-            err_msg << "Could not open file: " << std::quoted(path);
-            throw Exception(err_msg.str());
+        utils::MappedFile mapped {path};
+        BinaryReader in {mapped.view()};
+
+        char magic[sizeof(BINARY_MAGIC)] {};
+        in.get_array(magic, sizeof(magic));
+        if (std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0)
+            throw Exception("Incorrect format: not a binary record file.");
+        auto version = in.get<std::uint32_t>();
+        if (version == 0 || version > BINARY_VERSION)
+            throw Exception("Unsupported binary record version: " + std::to_string(version));
+
+        auto id = in.get_string();
+        auto name = in.get_string();
+        EmployeeRecord output { Employee{ EmployeeID{ id }, name }, resource };
+
+        auto job_count = in.get<std::uint32_t>();
+        in.align();
+        for (std::uint32_t i {0}; i < job_count; ++i)
+        {
+            JobID job { in.get_string() };
+            in.align();
+            WIRecord wi_rec {
+                read_record_columns(in, version, resource),
+                read_record_columns(in, version, resource)
+            };
+            output.add(std::move(job), std::move(wi_rec));
         }
+        return output;
+    }
+
+    auto EmployeeRecordIOUtils::import_record(
+            std::string const& path,
+            std::pmr::memory_resource* resource
+    ) -> EmployeeRecord
+    {
+        if (is_binary_record(path))
+            return import_record_binary(path, resource);
+
+        // The whole file is scanned in place; lines are views into the mapping.
+        utils::MappedFile mapped {path};
+        std::string_view remaining { mapped.view() };
 
-        std::string line {};
-        std::getline(file, line); 
-        std::istringstream iss {line};
-        
         // Get Employee
-        auto employee = parse_employee(iss);
-        if (!iss && !iss.eof())
-            throw Exception("Read Error.");
-        EmployeeRecord output {employee};
+        std::string_view line = next_line(remaining);
+        EmployeeRecord output { parse_employee(line), resource };
 
         // Skip blank line(s)
-        char check {};
         while (true)
         {
-            iss.clear();
-            std::getline(file, line);
-            iss.str(line);
-            // Chew up whitespace by attempting to read a character. This works due to the
-            // default behavior of an istream to skip whitespace.
-            if (iss >> check)
-                break;
-            else if (file.eof())
+            if (remaining.empty())
+            {
                 // Blank record
+                output.set_source(path, mapped.size(), {});
                 return output;
+            }
+            line = next_line(remaining);
+            seek_nonws(line);
+            if (!line.empty())
+                break;
         }
         // Parse Entries
         //
         // Condition: non-blank line
         //
-        // Since we are parsing files that were created with
-        // `EmployeeRecordIOUtils::export_record()`, we can make some assumptions (and
-        // guarantees) about what the file's structure. All lines from here contain
-        // complete information regarding the Entry, its containing Record's type, and the
-        // JobID associated with it. The sole exception to this statement is the trailing
-        // blank line at the end of the file. We don't wnat to deal with that, so we check
-        // if the line's non-empty.
+        // As with the original stream-based parser, all lines from here contain complete
+        // information regarding the Entry, its containing Record's type, and the JobID
+        // associated with it. The first empty line (ex. the trailing newline) ends the
+        // record.
+        //
+        // Each line is parsed straight into the columns of its Record (no `Entry` is
+        // formed), and each Record is built once at the end, which validates the whole
+        // column in a single pass. A job's lines are usually contiguous, so the lookup
+        // is skipped while the JobID token doesn't change. The columns are allocated
+        // from the output's resource so that the Records take them over.
+        using Buckets = std::pair<RecordColumns, RecordColumns>;
+        auto blank_columns = [resource]() -> RecordColumns {
+            return RecordColumns{
+                .dates=std::pmr::vector<std::chrono::year_month_day>(resource),
+                .metrics=std::pmr::vector<double>(resource),
+                .notes=std::pmr::string(resource),
+            };
+        };
+        std::map<std::string, Buckets, std::less<>> jobs {};
+        std::string_view current_job {};
+        Buckets* current {};
         while (!line.empty())
         {
-            iss.clear(); // clears eof status flag
-            iss.str(line);
+            auto job = take_job(line);
+            auto type = take_recordtype(line);
+            auto date = take_date(line);
+            auto notes = parse_flat_notes(line);
+
+            if (!current || job != current_job)
+            {
+                current = &jobs.try_emplace(std::string(job), blank_columns(), blank_columns()).first->second;
+                current_job = job;
+            }
+            auto& cols = (type == RecordType::Technical) ? current->first : current->second;
+            auto const dim = static_cast<int>(parse_metrics(line, cols.metrics));
+            assert(line.empty());
+            if (cols.dates.empty())
+                cols.dim = dim;
+            else if (dim != cols.dim)
+                throw Exception("Entry found with different number of numeric responses.");
+            cols.dates.push_back(date);
+            if (!notes.empty())
+                StringFlattener::append_expanded(cols.notes, notes);
+            if (cols.notes.size() > std::numeric_limits<std::uint32_t>::max())
+                throw Exception("Note storage limit exceeded.");
+            cols.note_offsets.push_back(static_cast<std::uint32_t>(cols.notes.size()));
+
+            line = next_line(remaining);
+        }
+        for (auto& [job, buckets]: jobs)
+        {
+            // Build the Records on the output's resource and move them into the map.
+            output.add(JobID{ job }, WIRecord{ Record(std::move(buckets.first), resource), Record(std::move(buckets.second), resource) });
+        }
 
-            auto job = parse_job(iss);
-            auto type = parse_recordtype(iss);
-            auto date = parse_date(iss);
-            auto notes = parse_notes(iss);
-            auto metrics = parse_metrics(iss);
-            assert(iss.eof());  // eof in this case means "end of line"
-            Entry e (date, notes, metrics);
-            output.add(job, type, e); 
+        // Reuse the job locations from an up-to-date index for incremental exports.
+        auto index = import_index(path);
+        bool const up_to_date { index && index->file_size == mapped.size() };
+        output.set_source(path, mapped.size(), up_to_date ? std::move(index->jobs) : std::map<JobID, JobRanges>{});
+        return output;
+    }
+    auto EmployeeRecordIOUtils::import_record_lazy(
+            std::string const& path,
+            std::pmr::memory_resource* resource
+    ) -> EmployeeRecord
+    {
+        if (is_binary_record(path))
+            return import_record_binary(path, resource);
 
-            // Get next line; This is done at the end of the iteration due to the way the
-            // function is structured. Not doing so would skip the first entry since we
-            // loaded that line previously when skipping the blank line(s).
-            std::getline(file, line);
+        std::error_code ec {};
+        auto const size = static_cast<std::uint64_t>(std::filesystem::file_size(path, ec));
+        if (ec)
+            throw Exception("Could not open file: " + path);
+
+        auto index = import_index(path);
+        bool const stale { !index || index->file_size != size };
+        if (!index || index->file_size > size)
+            index = build_index(path);
+        else if (index->file_size < size)
+            // Lines were appended (ex. by journal compaction); index only the new ones.
+            index = build_index(path, std::move(*index));
+        if (stale)
+        {
+            // The index only speeds up later loads, so failing to save it (ex. in a
+            // read-only directory) is not an error.
+            try {
+                export_index(*index, path);
+            } catch (Exception const&) {}
         }
 
+        std::ifstream file {path, std::ios::binary};
+        std::string first {};
+        if (!std::getline(file, first))
+            throw Exception("Could not read file: " + path);
+        if (!first.empty() && first.back() == '\r')
+            first.pop_back();
+        std::string_view line { first };
+        EmployeeRecord output { parse_employee(line), resource };
+
+        for (auto const& job: std::views::keys(index->jobs))
+        {
+            output.d_data.emplace(job, output.blank());
+            output.d_pending.insert(job);
+        }
+        output.set_source(path, size, std::move(index->jobs));
         return output;
     }
+
+    /* INDEX Functions */
+
+    auto EmployeeRecordIOUtils::index_path(std::string const& path) -> std::string
+    {
+        return path + INDEX_EXT;
+    }
+
+    auto EmployeeRecordIOUtils::build_index(std::string const& path, RecordIndex from) -> RecordIndex
+    {
+        utils::MappedFile mapped {path};
+        std::string_view const data { mapped.view() };
+        if (from.file_size > data.size())
+            throw Exception("Cannot extend index: record file is smaller than indexed.");
+
+        std::string_view remaining { data };
+        if (from.file_size == 0)
+        {
+            // Skip the Employee and the blank line(s) preceding the Entries.
+            next_line(remaining);
+            while (!remaining.empty())
+            {
+                auto peek = remaining;
+                auto line = next_line(peek);
+                seek_nonws(line);
+                if (!line.empty())
+                    break;
+                remaining = peek;
+            }
+        }
+        else
+            remaining.remove_prefix(from.file_size);
+
+        // As in `import_record`, the first empty line ends the Entries.
+        RecordIndex index { std::move(from) };
+        while (!remaining.empty())
+        {
+            auto const offset = static_cast<std::uint64_t>(remaining.data() - data.data());
+            auto line = next_line(remaining);
+            auto const length = static_cast<std::uint64_t>(remaining.data() - data.data()) - offset;
+            seek_nonws(line);
+            if (line.empty())
+                break;
+            auto job = parse_job(line);
+            auto type = parse_recordtype(line);
+
+            auto& job_ranges = index.jobs[JobID{ std::string(job) }];
+            auto& ranges = (type == RecordType::Technical) ? job_ranges.technical : job_ranges.personal;
+            if (!ranges.empty() && ranges.back().offset + ranges.back().length == offset)
+                ranges.back().length += length;
+            else
+                ranges.push_back(ByteRange{ offset, length });
+        }
+        index.file_size = data.size();
+        return index;
+    }
+
+    void EmployeeRecordIOUtils::export_index(RecordIndex const& index, std::string const& path)
+    {
+        std::ofstream file {index_path(path), std::ios::trunc};
+        if (!file.is_open())
+            throw Exception("Could not open file: " + index_path(path));
+        file << INDEX_MAGIC << ' ' << INDEX_VERSION << ' ' << index.file_size << '\n';
+        for (auto const& [job, ranges]: index.jobs)
+        {
+            for (auto const& r: ranges.technical)
+                file << job.formal() << ' ' << TECHINCAL_TKN << ' ' << r.offset << ' ' << r.length << '\n';
+            for (auto const& r: ranges.personal)
+                file << job.formal() << ' ' << PERSONAL_TKN << ' ' << r.offset << ' ' << r.length << '\n';
+        }
+        file.flush();
+        if (!file)
+            throw Exception("Could not write file: " + index_path(path));
+    }
+
+    auto EmployeeRecordIOUtils::import_index(std::string const& path) -> std::optional<RecordIndex>
+    {
+        std::ifstream file {index_path(path)};
+        if (!file.is_open())
+            return std::nullopt;
+
+        std::string magic {};
+        std::uint32_t version {};
+        RecordIndex index {};
+        if (!(file >> magic >> version >> index.file_size) || magic != INDEX_MAGIC || version != INDEX_VERSION)
+            return std::nullopt;
+
+        std::string job {};
+        char token {};
+        ByteRange range {};
+        while (file >> job >> token >> range.offset >> range.length)
+        {
+            if (range.offset > index.file_size || range.length > index.file_size - range.offset)
+                return std::nullopt;
+            auto& ranges = index.jobs[JobID{ job }];
+            switch (token)
+            {
+                case TECHINCAL_TKN:
+                    ranges.technical.push_back(range);
+                    break;
+                case PERSONAL_TKN:
+                    ranges.personal.push_back(range);
+                    break;
+                default:
+                    return std::nullopt;
+            }
+        }
+        if (!file.eof())
+            return std::nullopt;
+        return index;
+    }
+
     auto EmployeeRecordIOUtils::parse_employee(std::istringstream &iss) -> Employee
     {
         EmployeeRecordIOUtils::seek_nonws(iss);
@@ -277,9 +1198,14 @@ namespace ewi
     auto EmployeeRecordIOUtils::parse_date(std::istringstream &iss) -> std::chrono::year_month_day
     {
         EmployeeRecordIOUtils::seek_nonws(iss);
-        std::chrono::year_month_day date;
-        std::chrono::from_stream(iss, "%Y-%m-%d", date);
-        if (!iss)
+        std::string token {};
+        iss >> token;
+        if (auto date = utils::IsoDate::parse(token))
+            return *date;
+        // Non-canonical widths (ex. 2024-1-5), as accepted by `%Y-%m-%d`.
+        std::string_view view { token };
+        auto date = parse_date(view);
+        if (!view.empty())
             throw Exception("Incorrect format: Could not read date.");
         return date;
     }
@@ -317,9 +1243,10 @@ namespace ewi
         for (int i {0}; i < EmployeeRecordIOUtils::NUM_NOTES_DELIMS; ++i)
             notes.pop_back();
 
-        return StringFlattener::expand(notes);
+        StringFlattener::expand_in_place(notes);
+        return notes;
     }
-    auto EmployeeRecordIOUtils::parse_metrics(std::istringstream& iss) -> std::vector<double>
+    auto EmployeeRecordIOUtils::parse_metrics(std::istringstream& iss) -> MetricVector
     {
         EmployeeRecordIOUtils::seek_nonws(iss);
         /*
@@ -327,7 +1254,7 @@ namespace ewi
          * Therefore, we can continuously parse using std::strtod until the line ends.
          */
 
-        std::vector<double> metrics {};
+        MetricVector metrics {};
         std::string double_str {};
         char* remaining_str {};
         while (iss >> double_str)
@@ -344,5 +1271,94 @@ namespace ewi
     {
         iss >> std::ws;
     }
+
+    /* Buffer-based parsing */
+
+    auto EmployeeRecordIOUtils::parse_employee(std::string_view& line) -> Employee
+    {
+        seek_nonws(line);
+        auto delim = line.find(ID_DELIM);
+        std::string id { line.substr(0, delim) };
+        line.remove_prefix(delim == std::string_view::npos ? line.size() : delim + 1);
+
+        seek_nonws(line);
+        std::string name { line };
+        line = {};
+        return Employee{ EmployeeID{ id }, name };
+    }
+
+    auto EmployeeRecordIOUtils::parse_job(std::string_view& line) -> std::string_view
+    {
+        return take_job(line);
+    }
+
+    auto EmployeeRecordIOUtils::parse_recordtype(std::string_view& line) -> RecordType
+    {
+        return take_recordtype(line);
+    }
+
+    auto EmployeeRecordIOUtils::parse_date(std::string_view& line) -> std::chrono::year_month_day
+    {
+        return take_date(line);
+    }
+
+    auto EmployeeRecordIOUtils::parse_notes(std::string_view& line) -> std::string
+    {
+        std::string notes { parse_flat_notes(line) };
+        StringFlattener::expand_in_place(notes);
+        return notes;
+    }
+
+    auto EmployeeRecordIOUtils::parse_flat_notes(std::string_view& line) -> std::string_view
+    {
+        // The run of delimiters that opens and closes the notes.
+        static constexpr auto DELIMS = [] {
+            std::array<char, EmployeeRecordIOUtils::NUM_NOTES_DELIMS> delims {};
+            delims.fill(EmployeeRecordIOUtils::NOTES_DELIM);
+            return delims;
+        }();
+        constexpr std::string_view delims { DELIMS.data(), DELIMS.size() };
+
+        skip_spaces(line);
+        // Strip delimiter
+        if (!line.starts_with(delims))
+            throw Exception("Incorrect User Data Format.");
+        line.remove_prefix(delims.size());
+
+        // The notes end at the first run of closing delimiters.
+        auto end = line.find(delims);
+        if (end == std::string_view::npos)
+            throw TypedException<std::string>(std::string(line), Exception("Something went wrong when parsing notes."));
+        auto const notes = line.substr(0, end);
+        line.remove_prefix(end + delims.size());
+        return notes;
+    }
+
+    auto EmployeeRecordIOUtils::parse_metrics(std::string_view& line) -> MetricVector
+    {
+        MetricVector metrics {};
+        skip_spaces(line);
+        // Each value but (perhaps) the last is followed by a space, so this is an upper
+        // bound on the count.
+        auto const spaces = static_cast<std::size_t>(std::ranges::count(line, ' '));
+        metrics.reserve(line.ends_with(' ') ? spaces : spaces + 1);
+        append_metrics(line, metrics);
+        line = {};
+        return metrics;
+    }
+
+    auto EmployeeRecordIOUtils::parse_metrics(std::string_view& line, std::pmr::vector<double>& out) -> std::size_t
+    {
+        skip_spaces(line);
+        auto const before = out.size();
+        append_metrics(line, out);
+        line = {};
+        return out.size() - before;
+    }
+
+    void EmployeeRecordIOUtils::seek_nonws(std::string_view& line)
+    {
+        skip_spaces(line);
+    }
 }
 
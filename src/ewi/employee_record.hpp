@@ -34,26 +34,66 @@
 #define INCLUDED_STD_CHRONO
 #endif
 
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_CSTDINT
+#include <cstdint>
+#define INCLUDED_STD_CSTDINT
+#endif
+
 #ifndef INCLUDED_STD_MAP
 #include <map>
 #define INCLUDED_STD_MAP
 #endif
 
+#ifndef INCLUDED_STD_MEMORY_RESOURCE
+#include <memory_resource>
+#define INCLUDED_STD_MEMORY_RESOURCE
+#endif
+
 #ifndef INCLUDED_STD_OPTIONAL
 #include <optional>
 #define INCLUDED_STD_OPTIONAL
 #endif
 
+#ifndef INCLUDED_STD_SET
+#include <set>
+#define INCLUDED_STD_SET
+#endif
+
 #ifndef INCLUDED_STD_SSTREAM
 #include <sstream>
 #define INCLUDED_STD_SSTREAM
 #endif
 
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
 #ifndef INCLUDED_STD_STRING
 #include <string>
 #define INCLUDED_STD_STRING
 #endif
 
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
+#ifndef INCLUDED_STD_TUPLE
+#include <tuple>
+#define INCLUDED_STD_TUPLE
+#endif
+
+#ifndef INCLUDED_STD_UTILITY
+#include <utility>
+#define INCLUDED_STD_UTILITY
+#endif
+
 #ifndef INCLUDED_STD_VECTOR
 #include <vector>
 #define INCLUDED_STD_VECTOR
@@ -85,21 +125,88 @@ namespace ewi
     /// Entry should be placed while forming a WIRecord.
     enum class RecordType { Technical, Personal };
 
+    /// A span of bytes within a file.
+    struct ByteRange
+    {
+        std::uint64_t offset {};
+        std::uint64_t length {};
+
+        auto operator<=>(ByteRange const& rhs) const = default;
+    };
+
+    /// The byte ranges holding one job's Entry lines within a text record file, by
+    /// RecordType.
+    struct JobRanges
+    {
+        std::vector<ByteRange> technical {};
+        std::vector<ByteRange> personal {};
+
+        auto operator<=>(JobRanges const& rhs) const = default;
+    };
+
+    /// Maps each job of a text record file to the locations of its lines. `file_size` is
+    /// the size of the record file the index describes.
+    struct RecordIndex
+    {
+        std::uint64_t file_size {};
+        std::map<JobID, JobRanges> jobs {};
+
+        auto operator<=>(RecordIndex const& rhs) const = default;
+    };
+
     /// The class representing the employee's workload history for all job roles undertaken
     /// at a given company.
+    ///
+    /// A record opened with `EmployeeRecordIOUtils::import_record_lazy` knows its jobs
+    /// but parses a job's WIRecord only when it is first accessed. Any method that reads a
+    /// job's data (including comparisons) loads it first. The record file must not be
+    /// rewritten by other means while jobs are still pending; `export_record` loads
+    /// everything before writing.
+    ///
+    /// Since loading happens in const accessors, const access to a record with pending
+    /// jobs is not thread-safe. Call `load_all` before sharing such a record between
+    /// threads.
+    ///
+    /// A record read from or written to a text file remembers the versions (see
+    /// `Record::version`) of each job's Records at that point. A job is dirty if either
+    /// Record has changed since, which lets `EmployeeRecordIOUtils::export_record_incremental`
+    /// rewrite only what changed. Jobs that were never loaded are clean.
+    ///
+    /// The job map, the bookkeeping of lazy loading and incremental export, and the
+    /// Records of jobs created through `emplace` (including those read by the importers,
+    /// or loaded lazily) are allocated from the memory resource given at construction.
+    /// Loading many records into one arena (ex. a `std::pmr::monotonic_buffer_resource`)
+    /// and releasing it once they are no longer needed thus replaces one deallocation per
+    /// column with a single release. The resource must outlive the record, as well as any
+    /// Record moved out of it. Only the strings of the `Employee` and of each `JobID`
+    /// (usually short enough to be stored inline) and the byte ranges of each job's lines
+    /// are allocated separately; `Entry` objects are never stored.
     class EmployeeRecord
     {
         public:
-            EmployeeRecord(Employee emp)
-                : d_employee{ emp } {}
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            EmployeeRecord(Employee emp, std::pmr::memory_resource* resource=std::pmr::get_default_resource())
+                : d_employee{ std::move(emp) }, d_data{ resource }, d_pending{ resource },
+                  d_clean{ resource }, d_source{ resource }, d_segments{ resource } {}
 
             // MANIPULATORS
 
-            /// Adds a new job to the data set. Returns `false` and does no operation if the job is
-            /// already present.
-            void add(JobID job, WIRecord const& wi_rec);
+            /// Adds a new job to the data set. Throws an exception and does no operation if
+            /// the job is already present. Pass the WIRecord as an rvalue to move its
+            /// Records into place rather than copying them.
+            void add(JobID job, WIRecord wi_rec);
             /// Adds an Entry to the structure
             void add(JobID job, RecordType type, Entry const& entry);
+            /// Adds an Entry made of the given data, which is copied straight into the
+            /// Record (see `Record::emplace`) without building an `Entry` first.
+            void emplace(
+                    JobID job,
+                    RecordType type,
+                    std::chrono::year_month_day date,
+                    std::string_view notes,
+                    std::span<double const> metrics
+            );
             /// Returns a mutable reference to tbe given work record.
             /// Throws exception if the job isn't present.
             auto get_mut(JobID job) -> WIRecord&;
@@ -113,14 +220,80 @@ namespace ewi
 
             /// Return an iterator over the current job IDs in the record
             auto jobs() const;
+            /// Query if the job's WIRecord has been parsed. Always true for records that
+            /// were not opened lazily.
+            auto is_loaded(JobID const& job) const noexcept -> bool { return !d_pending.contains(job); }
+            /// Query if any job was added or modified since the record was last read from
+            /// or written to its file.
+            auto is_dirty() const -> bool;
+            /// Query if the job was added or modified since the record was last read from
+            /// or written to its file.
+            auto is_dirty(JobID const& job) const -> bool;
+            /// Returns the jobs that are dirty, in order.
+            auto dirty_jobs() const -> std::vector<JobID>;
+            /// Parses every job that has not been loaded yet, after which const access is
+            /// thread-safe (see class documentation).
+            /// Throws exception on I/O or format error.
+            void load_all() const;
+            /// Query the allocator the record's jobs are allocated from.
+            inline auto get_allocator() const noexcept -> allocator_type { return d_data.get_allocator(); }
+            /// Query the memory resource the record's jobs are allocated from.
+            inline auto resource() const noexcept -> std::pmr::memory_resource*
+            {
+                return d_data.get_allocator().resource();
+            }
             /// Return a refernce to the Employee
             inline auto who() const -> Employee const& { return d_employee; }
-            auto operator<=>(EmployeeRecord const& rhs) const  = default;
+            auto operator==(EmployeeRecord const& rhs) const -> bool;
+            auto operator<=>(EmployeeRecord const& rhs) const;
         private:
+            friend struct EmployeeRecordIOUtils;
+            /// Creates an empty WIRecord allocated from the record's resource.
+            auto blank() const -> WIRecord;
+            /// Parses the job's pending lines (if any) into its WIRecord.
+            void load(JobID const& job) const;
+            /// Records the current versions of the job's Records as its clean state.
+            void mark_clean(JobID const& job) const;
+            /// Associates the record with the text file at `path` whose contents it now
+            /// matches. `segments` locates each job's lines within the file.
+            void set_source(std::string path, std::uint64_t size, std::map<JobID, JobRanges> segments);
+
             Employee d_employee;
-            std::map<JobID, WIRecord> d_data {};
+            // Pending jobs hold an empty placeholder until loaded. Loading happens in
+            // const accessors, so the job data and its bookkeeping are mutable.
+            mutable std::pmr::map<JobID, WIRecord> d_data;
+            mutable std::pmr::set<JobID> d_pending;
+            /// Technical and personal Record versions of each job when last in sync with
+            /// `d_source`.
+            mutable std::pmr::map<JobID, std::pair<std::uint64_t, std::uint64_t>> d_clean;
+            /// The text record file this record was read from or last written to, its size
+            /// at the time, and the location of each job's lines within it (if known).
+            std::pmr::string d_source;
+            std::uint64_t d_source_size {};
+            std::pmr::map<JobID, JobRanges> d_segments;
     };
 
+    inline auto EmployeeRecord::operator==(EmployeeRecord const& rhs) const -> bool
+    {
+        load_all();
+        rhs.load_all();
+        return d_employee == rhs.d_employee && d_data == rhs.d_data;
+    }
+    inline auto EmployeeRecord::operator<=>(EmployeeRecord const& rhs) const
+    {
+        load_all();
+        rhs.load_all();
+        return std::tie(d_employee, d_data) <=> std::tie(rhs.d_employee, rhs.d_data);
+    }
+
+    /// How each Record is stored in a binary record file.
+    ///
+    /// - `Columns`: fixed-width columns that load with a memcpy each.
+    /// - `Compressed`: dates as deltas-of-deltas and each metric as an XOR-encoded series
+    ///   (see `utils::TimeSeriesCodec`), with note lengths as varints. Intended for
+    ///   archives; daily survey data shrinks several-fold.
+    enum class BinaryEncoding : std::uint32_t { Columns = 0, Compressed = 1 };
+
     /// A type that facilitates importing and exporting `EmployeeRecord` objects.
     struct EmployeeRecordIOUtils 
     {
@@ -136,6 +309,30 @@ namespace ewi
         /// The delimiter to separate EmployeeID from informal name.
         static constexpr char ID_DELIM {':'};
         
+        /// Binary (`.ewib`) format.
+        ///
+        /// The file begins with `BINARY_MAGIC` and the format version, followed by the
+        /// Employee and each job's WIRecord. A Record is stored as columns rather than
+        /// lines: a block of dates (days since the epoch), a flat row-major block of
+        /// metrics, and a notes heap addressed by an offset table. All integers are
+        /// little-endian, and every column begins on an 8-byte boundary.
+        ///
+        /// Version 2 precedes each Record's columns with its `BinaryEncoding`. Version 1
+        /// files (always `Columns`) remain readable.
+        static constexpr char BINARY_MAGIC[4] {'E', 'W', 'I', 'B'};
+        static constexpr std::uint32_t BINARY_VERSION { 2 };
+        static constexpr char BINARY_EXT[] { ".ewib" };
+
+        /// Offset index (`.idx`) sidecar.
+        ///
+        /// A text file stored next to the record file (`<record path>.idx`). The first
+        /// line holds `INDEX_MAGIC`, the format version, and the record file's size. Each
+        /// following line describes one run of consecutive Entry lines:
+        /// `<JobID> <T|P> <offset> <length>`.
+        static constexpr char INDEX_MAGIC[] { "EWIX" };
+        static constexpr std::uint32_t INDEX_VERSION { 1 };
+        static constexpr char INDEX_EXT[] { ".idx" };
+
         static inline constexpr char get_token(RecordType type)
         {
             return type==RecordType::Technical ? TECHINCAL_TKN : PERSONAL_TKN;
@@ -143,19 +340,60 @@ namespace ewi
 
         /* EXPORT Functions */
 
-        /// Output the entry to the provided stream. 
+        /// Enough characters for any double in its shortest round-trip form.
+        static constexpr std::size_t MAX_METRIC_CHARS { 32 };
+
+        /// Appends the entry's line to `buf`. Metrics are written with `std::to_chars` in
+        /// their shortest form that parses back to the identical value, independent of
+        /// the stream's locale and precision.
+        static void format_entry(
+                std::string& buf,
+                EntryView e,
+                JobID const& job,
+                RecordType type
+        );
+        /// Output the entry to the provided stream with a single write (see
+        /// `format_entry`). 
         /// This is function is intended to be used in order to preserve information for
         /// temp_file purposes. If the program crashes before having exported the user, we
         /// need to ensure the information was saved.
         static void export_entry(
                 std::ostream& os,
-                Entry const& e,
+                EntryView e,
                 JobID const& job,
                 RecordType type
         );
         /// Write an employee record to file in a format that is parsable by `load_record`.
+        /// Each Record is formatted into a reused buffer and written with one call.
+        ///
+        /// Only `path` is written unless `write_index` is set, in which case the file's
+        /// offset index (see `INDEX_MAGIC`) is written alongside it for
+        /// `import_record_lazy`. Leave it off for exports to user-chosen locations. An
+        /// existing index for `path` is removed if not rewritten, since it would be stale.
         /// Throws exception on I/O error.
-        static void export_record(EmployeeRecord const& rec, std::string const& path);
+        static void export_record(EmployeeRecord const& rec, std::string const& path, bool write_index=false);
+
+        /// Brings the text record file at `path` up to date with `rec`, rewriting as
+        /// little as possible:
+        ///
+        /// - Nothing is written if `path` is the file `rec` was read from or last written
+        ///   to, that file is unchanged, and no job is dirty.
+        /// - Otherwise, the file is rebuilt with each clean job's lines copied verbatim
+        ///   from the record's source file (jobs that were never loaded stay unparsed);
+        ///   only dirty jobs are formatted. The result is written to a temporary file
+        ///   and moved into place.
+        ///
+        /// `rec` is associated with `path` afterwards. Returns whether the file was
+        /// written. Throws exception on I/O error.
+        static auto export_record_incremental(EmployeeRecord& rec, std::string const& path) -> bool;
+
+        /// Write an employee record to file in the binary columnar format (see
+        /// `BINARY_MAGIC`). Throws exception on I/O error.
+        static void export_record_binary(
+                EmployeeRecord const& rec,
+                std::string const& path,
+                BinaryEncoding encoding=BinaryEncoding::Columns
+        );
 
         /* IMPORT Functions */
 
@@ -163,7 +401,53 @@ namespace ewi
         /// stores employee data in a designated directory. Each employee is represented by
         /// their formal ID value (`formalIDVal.txt`).  Throws an exception if the file doesn't
         /// exist or if the file is ill-formatted.
-        static auto import_record(std::string const& path) -> EmployeeRecord;
+        ///
+        /// Files written by `export_record_binary` are detected by their leading magic
+        /// bytes and loaded through `import_record_binary`.
+        ///
+        /// The record's data is allocated from `resource` (see `EmployeeRecord`).
+        static auto import_record(
+                std::string const& path,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+        ) -> EmployeeRecord;
+        /// Loads a record written by `export_record_binary`. The file is memory-mapped and
+        /// each Record's columns are copied out directly (or decoded, if compressed); no
+        /// text is parsed. Throws an
+        /// exception if the file is truncated or was written by an unknown version.
+        static auto import_record_binary(
+                std::string const& path,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+        ) -> EmployeeRecord;
+        /// Query if the file at `path` begins with the binary format's magic bytes.
+        static auto is_binary_record(std::string const& path) -> bool;
+        /// Opens a text record file without parsing its Entries. Each job's WIRecord is
+        /// parsed from the file the first time it is accessed (see `EmployeeRecord`), so
+        /// the cost of loading is proportional to the jobs actually used.
+        ///
+        /// The job locations come from the file's offset index, which is created or
+        /// brought up to date (ex. after journal compaction appended lines) as needed.
+        /// Binary record files are loaded in full. Throws an exception if the file
+        /// doesn't exist or if the file is ill-formatted.
+        static auto import_record_lazy(
+                std::string const& path,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+        ) -> EmployeeRecord;
+
+        /* INDEX Functions */
+
+        /// Query the sidecar index path for the record file at `path`.
+        static auto index_path(std::string const& path) -> std::string;
+        /// Locates each job's Entry lines in a text record file. Only the JobID and
+        /// RecordType tokens are parsed. Lines at or past `from.file_size` are scanned and
+        /// added to `from`, which allows extending the index of a file that has grown.
+        /// Throws exception on I/O or format error.
+        static auto build_index(std::string const& path, RecordIndex from={}) -> RecordIndex;
+        /// Writes `index` to the sidecar of the record file at `path`.
+        /// Throws exception on I/O error.
+        static void export_index(RecordIndex const& index, std::string const& path);
+        /// Reads the sidecar of the record file at `path`. Returns `std::nullopt` if it is
+        /// missing or unreadable.
+        static auto import_index(std::string const& path) -> std::optional<RecordIndex>;
 
         /// All parsing functions assume a well-formed file. This is reasonable, however,
         /// because all parsable EmployeeRecord files are to be created with this struct. 
@@ -191,9 +475,29 @@ namespace ewi
         /// the parsing method.  Assumes reasonable inputs.  This function does
         /// not check for Inf or NaN, as metrics should be validated when an
         /// Entry is created.
-        static auto parse_metrics(std::istringstream& iss) -> std::vector<double>;
+        static auto parse_metrics(std::istringstream& iss) -> MetricVector;
         /// Seeks next non-whitespace character.
         static void seek_nonws(std::istringstream& iss);
+
+        /// Buffer-based parsing functions.
+        ///
+        /// These mirror the stream-based functions above, but operate on a view of a
+        /// single line (without its newline). Each function consumes what it parses from
+        /// the front of `line`, so they are called in the same order. Tokens are read in
+        /// place and numbers are converted with `std::from_chars`; only the returned notes
+        /// and metrics allocate. `import_record` uses these on a memory-mapped file.
+        static auto parse_employee(std::string_view& line) -> Employee;
+        /// Returns a view of the JobID token within `line`.
+        static auto parse_job(std::string_view& line) -> std::string_view;
+        static auto parse_recordtype(std::string_view& line) -> RecordType;
+        static auto parse_date(std::string_view& line) -> std::chrono::year_month_day;
+        static auto parse_notes(std::string_view& line) -> std::string;
+        /// Returns a view of the (still flattened) notes within `line`.
+        static auto parse_flat_notes(std::string_view& line) -> std::string_view;
+        static auto parse_metrics(std::string_view& line) -> MetricVector;
+        /// Appends the metrics to `out` and returns how many there were.
+        static auto parse_metrics(std::string_view& line, std::pmr::vector<double>& out) -> std::size_t;
+        static void seek_nonws(std::string_view& line);
     };
 }  // namespace ewi
 #endif // INCLUDED_EWI_EMPLOYEE_RECORD
@@ -18,12 +18,22 @@
 */
 #include "employee_record.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <cpperrors>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 #include <utils/string_flattener/string_flattener.hpp>
@@ -32,6 +42,39 @@ using namespace ewi;
 using namespace std::chrono_literals;
 using utils::StringFlattener;
 
+namespace
+{
+    /// Counts the allocations made through it; they are served by the default resource.
+    class CountingResource : public std::pmr::memory_resource
+    {
+        public:
+            /// Counts the allocations made while running `f`.
+            template<typename F>
+            auto allocations_during(F&& f) -> std::size_t
+            {
+                auto const before = d_allocations;
+                f();
+                return d_allocations - before;
+            }
+        private:
+            auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+            {
+                ++d_allocations;
+                return std::pmr::get_default_resource()->allocate(bytes, alignment);
+            }
+            void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+            {
+                std::pmr::get_default_resource()->deallocate(ptr, bytes, alignment);
+            }
+            auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override
+            {
+                return this == &other;
+            }
+
+            std::size_t d_allocations {};
+    };
+}
+
 
 /// A convenience function for generating records for this test.
 auto gen_record() -> Record 
@@ -78,6 +121,241 @@ void test_ER_IO()
     auto parsed_rec = EmployeeRecordIOUtils::import_record(file_name);
     EmployeeRecordIOUtils::export_record(parsed_rec, "bugs_check.txt");
     assert(parsed_rec == emp_rec);
+
+    // Exporting to a user-chosen location writes that file alone.
+    std::filesystem::path const dir {"bugs_export"};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directory(dir);
+    EmployeeRecordIOUtils::export_record(emp_rec, (dir / "bugs.txt").string());
+    auto const files = std::vector<std::filesystem::directory_entry>(
+            std::filesystem::directory_iterator{ dir }, std::filesystem::directory_iterator{});
+    assert(files.size() == 1 && files[0].path().filename() == "bugs.txt");
+    std::filesystem::remove_all(dir);
+}
+
+/// Copies the binary record file at `path` to `out`, replacing the entry count and metric
+/// count of its first Record (three entries of five metrics each; see `gen_record`).
+void corrupt_header(std::string const& path, std::string const& out, std::uint32_t count, std::uint32_t dim)
+{
+    std::ifstream in {path, std::ios::binary};
+    std::string data { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+    std::uint32_t const header[] { 3, 5 };
+    auto pos = data.find(std::string_view{ reinterpret_cast<char const*>(header), sizeof(header) });
+    assert(pos != std::string::npos);
+    std::uint32_t const corrupt[] { count, dim };
+    std::memcpy(data.data() + pos, corrupt, sizeof(corrupt));
+    std::ofstream { out, std::ios::binary } << data;
+}
+
+/// Query if importing the file fails with a format error (rather than, say, `std::bad_alloc`).
+auto rejects(std::string const& path) -> bool
+{
+    try {
+        EmployeeRecordIOUtils::import_record_binary(path);
+    } catch (cpperrors::Exception const&) {
+        return true;
+    }
+    return false;
+}
+
+/// Tests the binary format by exporting and then reimporting an instance.
+void test_ER_binary_IO()
+{
+    Employee person { EmployeeID { "55555"}, "Bugs Bunny" };
+    EmployeeRecord emp_rec { person };
+    emp_rec.add(JobID{ "1940" }, WIRecord{ gen_record(), gen_record() });
+    emp_rec.add(JobID{ "1970" }, WIRecord{ gen_record(), Record{} });
+
+    std::string file_name {"bugs_record_00.ewib"};
+    EmployeeRecordIOUtils::export_record_binary(emp_rec, file_name);
+    assert(EmployeeRecordIOUtils::is_binary_record(file_name));
+
+    auto parsed_rec = EmployeeRecordIOUtils::import_record_binary(file_name);
+    assert(parsed_rec == emp_rec);
+    // The text importer recognizes and defers to the binary format.
+    assert(EmployeeRecordIOUtils::import_record(file_name) == emp_rec);
+
+    // Headers describing more data than the file holds are rejected before allocating.
+    std::string const corrupt_name {"bugs_record_corrupt.ewib"};
+    for (auto [count, dim]: { std::pair{ UINT32_MAX, 5u }, std::pair{ 3u, UINT32_MAX }, std::pair{ UINT32_MAX, UINT32_MAX },
+            std::pair{ 4096u, 5u } })
+    {
+        corrupt_header(file_name, corrupt_name, count, dim);
+        assert(rejects(corrupt_name));
+    }
+
+    // Compressed Records decode to the same data.
+    std::string packed_name {"bugs_record_01.ewib"};
+    EmployeeRecordIOUtils::export_record_binary(emp_rec, packed_name, BinaryEncoding::Compressed);
+    assert(EmployeeRecordIOUtils::import_record(packed_name) == emp_rec);
+    assert(std::filesystem::file_size(packed_name) < std::filesystem::file_size(file_name));
+    for (auto [count, dim]: { std::pair{ UINT32_MAX, 5u }, std::pair{ 3u, UINT32_MAX }, std::pair{ 0u, 5u },
+            std::pair{ 4096u, 5u } })
+    {
+        corrupt_header(packed_name, corrupt_name, count, dim);
+        assert(rejects(corrupt_name));
+    }
+
+    // Round-trip through the text format to ensure the two stay interchangeable.
+    EmployeeRecordIOUtils::export_record(parsed_rec, "bugs_record_01.txt");
+    assert(!EmployeeRecordIOUtils::is_binary_record("bugs_record_01.txt"));
+    assert(EmployeeRecordIOUtils::import_record("bugs_record_01.txt") == emp_rec);
+}
+
+/// Tests importing into a caller-provided memory resource.
+void test_ER_arena_IO()
+{
+    Employee person { EmployeeID { "55555"}, "Bugs Bunny" };
+    JobID const job { "1940" };
+    EmployeeRecord emp_rec { person };
+    emp_rec.add(job, WIRecord{ gen_record(), gen_record() });
+    emp_rec.add(JobID{ "1970" }, WIRecord{ gen_record(), Record{} });
+    std::string const text_name {"bugs_record_02.txt"};
+    std::string const binary_name {"bugs_record_02.ewib"};
+    EmployeeRecordIOUtils::export_record(emp_rec, text_name);
+    EmployeeRecordIOUtils::export_record_binary(emp_rec, binary_name);
+
+    // The arena has no upstream, so anything the records allocate elsewhere would throw.
+    std::vector<std::byte> buffer (256 * 1024);
+    std::pmr::monotonic_buffer_resource arena { buffer.data(), buffer.size(), std::pmr::null_memory_resource() };
+    for (auto const& path: { text_name, binary_name })
+    {
+        auto parsed_rec = EmployeeRecordIOUtils::import_record(path, &arena);
+        assert(parsed_rec == emp_rec);
+        assert(parsed_rec.resource() == &arena);
+        assert(parsed_rec.get(job).technical.resource() == &arena);
+        assert(parsed_rec.get(job).personal.resource() == &arena);
+
+        // New jobs share the arena; copied Records go back to the default resource.
+        parsed_rec.add(JobID{ "2000" }, RecordType::Personal,
+                Entry(2024y / std::chrono::November / 12d, "", std::vector<double>{ 1. }));
+        assert(parsed_rec.get(JobID{ "2000" }).personal.resource() == &arena);
+        Record const copy { parsed_rec.get(job).technical };
+        assert(copy == emp_rec.get(job).technical);
+        assert(copy.resource() == std::pmr::get_default_resource());
+    }
+
+    auto lazy_rec = EmployeeRecordIOUtils::import_record_lazy(text_name, &arena);
+    assert(lazy_rec.get(job).technical.resource() == &arena);
+    assert(lazy_rec == emp_rec);
+
+    // The records' containers never fall back to the default resource: importing, loading
+    // lazily, summarizing, and exporting succeed with a default resource that always throws.
+    auto* const previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    for (auto const& path: { text_name, binary_name })
+    {
+        auto parsed_rec = EmployeeRecordIOUtils::import_record(path, &arena);
+        assert(parsed_rec.get(job).technical.summarize(DateRange{}));
+        EmployeeRecordIOUtils::export_record(parsed_rec, text_name);
+    }
+    auto lazy_arena_rec = EmployeeRecordIOUtils::import_record_lazy(text_name, &arena);
+    lazy_arena_rec.load_all();
+    Record const arena_copy { lazy_arena_rec.get(job).personal, &arena };
+    assert(arena_copy.resource() == &arena && arena_copy.summarize(DateRange{}));
+    std::pmr::set_default_resource(previous);
+    assert(lazy_arena_rec == emp_rec);
+}
+
+/// Tests loading jobs on demand through the offset index.
+void test_ER_lazy_IO()
+{
+    Employee person { EmployeeID { "55555"}, "Bugs Bunny" };
+    JobID merry_melodies { "1940" };
+    JobID looney_tunes { "1970" };
+    EmployeeRecord emp_rec { person };
+    emp_rec.add(merry_melodies, WIRecord{ gen_record(), gen_record() });
+    emp_rec.add(looney_tunes, WIRecord{ gen_record(), Record{} });
+
+    std::string file_name {"bugs_record_lazy.txt"};
+    EmployeeRecordIOUtils::export_record(emp_rec, file_name, true);
+    auto index = EmployeeRecordIOUtils::import_index(file_name);
+    assert(index && *index == EmployeeRecordIOUtils::build_index(file_name));
+    assert(index->jobs.size() == 2 && index->jobs.at(looney_tunes).personal.empty());
+
+    auto lazy = EmployeeRecordIOUtils::import_record_lazy(file_name);
+    assert(lazy.who() == person);
+    assert(!lazy.is_loaded(merry_melodies) && !lazy.is_loaded(looney_tunes));
+    assert(lazy.get(looney_tunes) == emp_rec.get(looney_tunes));
+    assert(lazy.is_loaded(looney_tunes) && !lazy.is_loaded(merry_melodies));
+    assert(lazy == emp_rec);
+    assert(lazy.is_loaded(merry_melodies));
+
+    // Appended lines (ex. from journal compaction) are picked up by extending the index.
+    Entry later ( std::chrono::year_month_day(2024y, std::chrono::December, 1d), "Appended", std::vector<double>{1., 2., 3., 4., 5.} );
+    {
+        std::ofstream file {file_name, std::ios::app};
+        EmployeeRecordIOUtils::export_entry(file, later, looney_tunes, RecordType::Personal);
+    }
+    emp_rec.add(looney_tunes, RecordType::Personal, later);
+    auto grown = EmployeeRecordIOUtils::import_record_lazy(file_name);
+    assert(EmployeeRecordIOUtils::import_index(file_name)->file_size == std::filesystem::file_size(file_name));
+    assert(grown.get(looney_tunes) == emp_rec.get(looney_tunes));
+    assert(grown == emp_rec);
+
+    // A missing or damaged index is rebuilt.
+    std::filesystem::remove(EmployeeRecordIOUtils::index_path(file_name));
+    assert(EmployeeRecordIOUtils::import_record_lazy(file_name) == emp_rec);
+    std::ofstream { EmployeeRecordIOUtils::index_path(file_name) } << "garbage";
+    assert(EmployeeRecordIOUtils::import_record_lazy(file_name) == emp_rec);
+    // A range whose end wraps around past the file's size is rejected.
+    std::ofstream { EmployeeRecordIOUtils::index_path(file_name) } << EmployeeRecordIOUtils::INDEX_MAGIC << ' '
+        << EmployeeRecordIOUtils::INDEX_VERSION << ' ' << std::filesystem::file_size(file_name) << '\n'
+        << merry_melodies.formal() << ' ' << EmployeeRecordIOUtils::PERSONAL_TKN << ' ' << UINT64_MAX << " 2\n";
+    assert(!EmployeeRecordIOUtils::import_index(file_name));
+    assert(EmployeeRecordIOUtils::import_record_lazy(file_name) == emp_rec);
+
+    // Re-exporting a lazily-opened record over its own file loads everything first.
+    auto reopened = EmployeeRecordIOUtils::import_record_lazy(file_name);
+    EmployeeRecordIOUtils::export_record(reopened, file_name);
+    assert(EmployeeRecordIOUtils::import_record(file_name) == emp_rec);
+}
+
+/// Tests that exports rewrite only what changed.
+void test_ER_incremental_export()
+{
+    namespace fs = std::filesystem;
+    Employee person { EmployeeID { "55555"}, "Bugs Bunny" };
+    JobID merry_melodies { "1940" };
+    JobID looney_tunes { "1970" };
+    EmployeeRecord emp_rec { person };
+    emp_rec.add(merry_melodies, WIRecord{ gen_record(), gen_record() });
+    emp_rec.add(looney_tunes, WIRecord{ gen_record(), Record{} });
+    assert(emp_rec.is_dirty());
+
+    std::string file_name {"bugs_record_incremental.txt"};
+    fs::remove(file_name);
+    assert(EmployeeRecordIOUtils::export_record_incremental(emp_rec, file_name));
+    assert(!emp_rec.is_dirty());
+    assert(EmployeeRecordIOUtils::import_record(file_name) == emp_rec);
+    // Nothing changed; nothing is written.
+    auto const written = fs::last_write_time(file_name);
+    assert(!EmployeeRecordIOUtils::export_record_incremental(emp_rec, file_name));
+    assert(fs::last_write_time(file_name) == written);
+
+    // Only the modified job is dirty; the other is copied from the file.
+    auto lazy = EmployeeRecordIOUtils::import_record_lazy(file_name);
+    assert(!lazy.is_dirty());
+    Entry later ( std::chrono::year_month_day(2024y, std::chrono::December, 1d), "Later", std::vector<double>{1., 2., 3., 4., 5.} );
+    lazy.add(looney_tunes, RecordType::Technical, later);
+    emp_rec.add(looney_tunes, RecordType::Technical, later);
+    assert(lazy.dirty_jobs() == std::vector<JobID>{ looney_tunes });
+    assert(EmployeeRecordIOUtils::export_record_incremental(lazy, file_name));
+    assert(!lazy.is_loaded(merry_melodies) && !lazy.is_dirty());
+    assert(EmployeeRecordIOUtils::import_record(file_name) == emp_rec);
+    assert(*EmployeeRecordIOUtils::import_index(file_name) == EmployeeRecordIOUtils::build_index(file_name));
+    // Jobs left pending are read from the rewritten file.
+    assert(lazy == emp_rec);
+
+    // Replacing a Record wholesale is a change, as is adding a job.
+    lazy.get_mut(merry_melodies).personal = gen_record();
+    assert(lazy.is_dirty(merry_melodies));
+    lazy.add(JobID{ "1999" }, WIRecord{});
+    assert(lazy.dirty_jobs().size() == 2);
+
+    // Exporting elsewhere always writes.
+    auto reread = EmployeeRecordIOUtils::import_record(file_name);
+    assert(EmployeeRecordIOUtils::export_record_incremental(reread, "bugs_record_incremental_copy.txt"));
+    assert(EmployeeRecordIOUtils::import_record("bugs_record_incremental_copy.txt") == emp_rec);
 }
 
 /// Tests `EmployeeRecordIOUtils::parse_employee()`
@@ -109,7 +387,7 @@ void test_entry_parse()
     RecordType rec_type;
     std::chrono::year_month_day date;
     std::string notes {};
-    std::vector<double> metrics {};
+    MetricVector metrics {};
 
     std::istringstream iss {ss.str()};
 
@@ -124,7 +402,103 @@ void test_entry_parse()
     assert(date == std::chrono::year_month_day(2024y, std::chrono::November, 11d));
     assert(notes == "These are notes\nthat have multiple lines.");
     std::vector<double> vec { 0, 3.22, 4.556, 10 };
-    assert(metrics == vec);
+    assert(std::ranges::equal(metrics, vec));
+
+    // The buffer-based parsers must agree with the stream-based ones.
+    std::string const line { ss.str() };
+    std::string_view view { line };
+    assert(EmployeeRecordIOUtils::parse_job(view) == "0260");
+    assert(EmployeeRecordIOUtils::parse_recordtype(view) == rec_type);
+    assert(EmployeeRecordIOUtils::parse_date(view) == date);
+    assert(EmployeeRecordIOUtils::parse_notes(view) == notes);
+    assert(std::ranges::equal(EmployeeRecordIOUtils::parse_metrics(view), vec));
+    assert(view.empty());
+
+    std::string_view employee { "ID2456791: Terrance Williams" };
+    auto person = EmployeeRecordIOUtils::parse_employee(employee);
+    assert(person.id == EmployeeID{"ID2456791"} && person.name == "Terrance Williams");
+}
+
+/// Exported metrics must parse back to the identical doubles.
+void test_metric_round_trip()
+{
+    std::vector<double> const vals {
+        0.1, 1. / 3., -2. / 7., 1e-300, 4.9406564584124654e-324, 1.7976931348623157e308,
+        123456789.123456789, -0., 3.14159, 1e21, 6.02214076e23
+    };
+    Entry const e { std::chrono::year_month_day(2024y, std::chrono::November, 12d), "Precise.", vals };
+    std::string line {};
+    EmployeeRecordIOUtils::format_entry(line, e, JobID{ "0260" }, RecordType::Personal);
+
+    std::ostringstream oss {};
+    EmployeeRecordIOUtils::export_entry(oss, e, JobID{ "0260" }, RecordType::Personal);
+    assert(oss.str() == line);
+
+    std::string_view view { line };
+    EmployeeRecordIOUtils::parse_job(view);
+    EmployeeRecordIOUtils::parse_recordtype(view);
+    EmployeeRecordIOUtils::parse_date(view);
+    assert(EmployeeRecordIOUtils::parse_notes(view) == "Precise.");
+    auto const parsed = EmployeeRecordIOUtils::parse_metrics(view);
+    assert(parsed.size() == vals.size());
+    for (std::size_t i {0}; i < vals.size(); ++i)
+        assert(std::bit_cast<std::uint64_t>(parsed[i]) == std::bit_cast<std::uint64_t>(vals[i]));
+}
+
+/// Ingestion must allocate at most once per buffer an Entry owns (its notes, if too long
+/// for the string itself, and its metrics, if too many to store inline).
+void test_ingestion_allocations()
+{
+    using namespace std::chrono;
+    constexpr std::size_t DIM { 12 };  // more than any inline capacity
+    std::string const long_notes { "Notes too long to be stored inline." };
+    std::vector<double> const values(DIM, 1.5);
+
+    // Entries built from rvalues take over the buffers; those built from lvalues copy them.
+    std::string notes { long_notes };
+    MetricVector metrics { values.begin(), values.end() };
+    auto const* const notes_data = notes.data();
+    auto const* const metrics_data = metrics.data();
+    Entry const moved { 2024y / November / 1d, std::move(notes), std::move(metrics) };
+    assert(moved.notes().data() == notes_data && moved.metrics().data() == metrics_data);
+    Entry const copied { 2024y / November / 1d, long_notes, values };
+    assert(copied.notes().data() != long_notes.data() && copied.metrics().data() != values.data());
+
+    // Appending to a Record costs no allocation of its own beyond amortized growth.
+    auto gen_entries = [&](int count) -> std::vector<Entry> {
+        std::vector<Entry> entries {};
+        sys_days day { 2000y / January / 1d };
+        for (int i {0}; i < count; ++i, day += days{1})
+            entries.emplace_back(year_month_day{ day }, long_notes, values);
+        return entries;
+    };
+    auto const entries = gen_entries(4096);
+    CountingResource counter {};
+    Record rec { &counter };
+    auto const appends = counter.allocations_during([&] {
+        for (auto const& e: entries)
+            rec.emplace(e.date(), e.notes(), e.metrics());
+    });
+    assert(appends < entries.size() / 8);
+
+    // Moving a job's Records into an EmployeeRecord allocates only the map node.
+    EmployeeRecord emp_rec { Employee{ EmployeeID{ "00001" }, "Porky Pig" }, &counter };
+    WIRecord wi_rec { std::move(rec), Record{ &counter } };
+    assert(counter.allocations_during([&] { emp_rec.add(JobID{ "1935" }, std::move(wi_rec)); }) == 1);
+    assert(emp_rec.get(JobID{ "1935" }).technical.size() == static_cast<int>(entries.size()));
+
+    // The record's storage costs no allocation per imported Entry; all growth is
+    // amortized. Compare two imports so that per-file costs cancel out.
+    auto import_cost = [&](int count) -> std::size_t {
+        std::string const path { "porky_record.txt" };
+        EmployeeRecord out { Employee{ EmployeeID{ "00001" }, "Porky Pig" } };
+        auto batch = gen_entries(count);
+        out.add(JobID{ "1935" }, WIRecord{ Record(batch), Record{} });
+        EmployeeRecordIOUtils::export_record(out, path);
+        return counter.allocations_during([&] { EmployeeRecordIOUtils::import_record(path, &counter); });
+    };
+    auto const small = import_cost(2048), large = import_cost(4096);
+    assert(large - small < 2048 / 8);
 }
 
 int main()
@@ -133,7 +507,13 @@ int main()
     try {
         test_employee_parse();
         test_entry_parse();
+        test_metric_round_trip();
         test_ER_IO();
+        test_ER_binary_IO();
+        test_ER_arena_IO();
+        test_ER_lazy_IO();
+        test_ER_incremental_export();
+        test_ingestion_allocations();
     } catch (TypedException<std::string> const& e) {
         std::cerr << e.err().report(true) << "\n" 
             << "Data: " << e.data() << "\n";
@@ -0,0 +1,197 @@
+// entry.b.cpp
+// Entry Metric Storage Benchmark Driver
+//
+// Usage: bench_entry [num_entries]
+//
+// Counts the allocations made while creating Entries and importing a record of
+// `num_entries` (default 1M) entries. Configure with `-DEWI_ENTRY_INLINE_METRICS=0` to
+// compare against heap-allocated metrics.
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "entry.hpp"
+//- STL
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <ewi/employee_record.hpp>
+
+using namespace ewi;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    std::size_t g_allocations {};
+    std::size_t g_allocated_bytes {};
+}
+
+auto operator new(std::size_t bytes) -> void*
+{
+    ++g_allocations;
+    g_allocated_bytes += bytes;
+    if (void* ptr = std::malloc(bytes ? bytes : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+    /// The Entry layout used before inline metric storage.
+    struct HeapEntry
+    {
+        std::chrono::year_month_day date;
+        std::string notes;
+        std::vector<double> metrics;
+    };
+
+    /// Allocations, bytes requested, and best time of running `f` (three runs).
+    struct Cost
+    {
+        std::size_t allocations {};
+        std::size_t bytes {};
+        double seconds { 1e300 };
+    };
+
+    template<typename F>
+    auto measure(F&& f) -> Cost
+    {
+        Cost cost {};
+        for (int i {0}; i < 3; ++i)
+        {
+            auto const allocations = g_allocations, bytes = g_allocated_bytes;
+            auto start = Clock::now();
+            f();
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            cost = { g_allocations - allocations, g_allocated_bytes - bytes, std::min(cost.seconds, elapsed.count()) };
+        }
+        return cost;
+    }
+
+    void report(std::string const& label, Cost const& cost, int num_entries)
+    {
+        std::cout << "  " << label << ": " << cost.seconds * 1e3 << " ms, "
+            << static_cast<double>(cost.allocations) / num_entries << " allocations/entry, "
+            << static_cast<double>(cost.bytes) / (1024. * 1024.) << " MiB requested\n";
+    }
+
+    /// Survey-like values: five metrics per entry and a note on every seventh.
+    auto metric_value(int entry, int col) -> double { return 0.5 * ((entry * 3 + col) % 9); }
+    auto note_for(int entry) -> std::string { return (entry % 7 == 0) ? "Weekly sync." : ""; }
+    constexpr int DIM { 5 };
+}
+
+void bench_creation(int num_entries);
+void bench_import(int num_entries);
+
+int main(int argc, char* argv[])
+{
+    int num_entries { argc > 1 ? std::atoi(argv[1]) : 1'000'000 };
+    try {
+        std::cout << "EWI_ENTRY_INLINE_METRICS=" << EWI_ENTRY_INLINE_METRICS
+            << ", sizeof(Entry)=" << sizeof(Entry) << "\n";
+        bench_creation(num_entries);
+        bench_import(num_entries);
+    } catch (cpperrors::Exception const& e) {
+        std::cerr << e.report(true) << "\n";
+        return 1;
+    }
+}
+//--------------------------------------------------------------------------------------------------
+/// Creates Entries the way the importer does (metrics parsed one value at a time, then
+/// moved into the Entry) and compares them with the previous vector-based layout.
+void bench_creation(int num_entries)
+{
+    using namespace std::chrono;
+    sys_days const start { 1990y / January / 1d };
+    std::vector<HeapEntry> heap_entries {};
+    std::vector<Entry> entries {};
+    auto const heap_cost = measure([&] {
+        heap_entries.clear();
+        heap_entries.shrink_to_fit();
+        heap_entries.reserve(static_cast<std::size_t>(num_entries));
+        for (int i {0}; i < num_entries; ++i)
+        {
+            std::vector<double> metrics {};
+            metrics.reserve(DIM);
+            for (int col {0}; col < DIM; ++col)
+                metrics.push_back(metric_value(i, col));
+            heap_entries.push_back(HeapEntry{ year_month_day{ start + days{i} }, note_for(i), std::move(metrics) });
+        }
+    });
+    auto const cost = measure([&] {
+        entries.clear();
+        entries.shrink_to_fit();
+        entries.reserve(static_cast<std::size_t>(num_entries));
+        for (int i {0}; i < num_entries; ++i)
+        {
+            MetricVector metrics {};
+            metrics.reserve(DIM);
+            for (int col {0}; col < DIM; ++col)
+                metrics.push_back(metric_value(i, col));
+            entries.emplace_back(year_month_day{ start + days{i} }, note_for(i), std::move(metrics));
+        }
+    });
+    for (int i {0}; i < num_entries; i += 997)
+        if (!std::ranges::equal(heap_entries[i].metrics, entries[i].metrics()))
+            throw cpperrors::Exception("Entries differ.");
+
+    std::cout << "<bench_creation> " << num_entries << " entries of " << DIM << " metrics\n";
+    report("std::vector metrics", heap_cost, num_entries);
+    report("MetricVector       ", cost, num_entries);
+    std::cout << "  speedup: " << heap_cost.seconds / cost.seconds << "x\n";
+}
+//--------------------------------------------------------------------------------------------------
+/// Imports a text record file holding one Record of `num_entries` entries.
+void bench_import(int num_entries)
+{
+    using namespace std::chrono;
+    std::string const path { "bench_entry.txt" };
+    {
+        sys_days day { 1990y / January / 1d };
+        std::vector<Entry> entries {};
+        for (int i {0}; i < num_entries; ++i, day += days{1})
+        {
+            MetricVector metrics {};
+            for (int col {0}; col < DIM; ++col)
+                metrics.push_back(metric_value(i, col));
+            entries.emplace_back(year_month_day{ day }, note_for(i), std::move(metrics));
+        }
+        EmployeeRecord rec { Employee{ EmployeeID{ "E0001" }, "Benchmark User" } };
+        rec.add(JobID{ "J0" }, WIRecord{ Record(entries), Record() });
+        EmployeeRecordIOUtils::export_record(rec, path);
+    }
+    int imported {};
+    auto const cost = measure([&] {
+        imported = EmployeeRecordIOUtils::import_record(path).get(JobID{ "J0" }).technical.size();
+    });
+    if (imported != num_entries)
+        throw cpperrors::Exception("Import lost entries.");
+
+    std::cout << "<bench_import> " << num_entries << " entries, "
+        << static_cast<double>(std::filesystem::file_size(path)) / (1024. * 1024.) << " MiB\n";
+    report("import_record", cost, num_entries);
+}
@@ -17,10 +17,12 @@
 */
 #include "entry.hpp"
 //- STL
-#include <format>
+#include <algorithm>
 #include <iostream>
+#include <string>
 #include <vector>
 //- In-house
+#include <utils/iso_date.hpp>
 #include <utils/string_flattener/string_flattener.hpp>
 
 namespace ewi
@@ -32,18 +34,25 @@ namespace ewi
             return false;
         if (a.notes() != b.notes())
             return false;
-        // vector comp
-        auto a_vec = a.metrics();
-        auto b_vec = b.metrics();
-        if (a_vec.size() != b_vec.size())
-            return false;
-        return a_vec == b_vec;
+        return std::ranges::equal(a.metrics(), b.metrics());
     }
 
     auto operator<< (std::ostream& os, Entry const& e) noexcept -> std::ostream&
     {
-        os << std::format("{:%F}", e.date()) << ' '
-           << utils::StringFlattener::flatten(e.notes()) << ' ';
+        return os << EntryView{ e };
+    }
+
+    auto operator== (EntryView const& a, EntryView const& b) noexcept -> bool
+    {
+        return a.date() == b.date() && a.notes() == b.notes()
+            && std::ranges::equal(a.metrics(), b.metrics());
+    }
+
+    auto operator<< (std::ostream& os, EntryView const& e) noexcept -> std::ostream&
+    {
+        os << utils::IsoDate::to_string(e.date()) << ' ';
+        utils::StringFlattener::flatten(e.notes(), os);
+        os << ' ';
     
         for (double d: e.metrics())
             os << d << " "; 
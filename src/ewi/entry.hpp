@@ -28,18 +28,54 @@
 #define INCLUDED_STD_OSTREAM
 #endif
 
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
 #ifndef INCLUDED_STD_STRING
 #include <string>
 #define INCLUDED_STD_STRING
 #endif
 
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
+#ifndef INCLUDED_STD_UTILITY
+#include <utility>
+#define INCLUDED_STD_UTILITY
+#endif
+
 #ifndef INCLUDED_STD_VECTOR
 #include <vector>
 #define INCLUDED_STD_VECTOR
 #endif
 
+/// The number of metrics an Entry holds without allocating (see `MetricVector`). Job
+/// profiles have three to eight metrics and personal surveys five, so the default covers
+/// them all. Define as 0 to keep every Entry's metrics in a `std::vector`.
+#ifndef EWI_ENTRY_INLINE_METRICS
+#define EWI_ENTRY_INLINE_METRICS 8
+#endif
+
+#if EWI_ENTRY_INLINE_METRICS > 0
+#ifndef INCLUDED_SMALL_VECTOR
+#include <utils/small_vector.hpp>
+#endif
+#endif
+
 namespace ewi
 {
+    /// An Entry's metrics. Up to `EWI_ENTRY_INLINE_METRICS` values are stored inside the
+    /// Entry itself, so creating or copying a typical Entry allocates nothing for them.
+#if EWI_ENTRY_INLINE_METRICS > 0
+    using MetricVector = utils::SmallVector<double, EWI_ENTRY_INLINE_METRICS>;
+#else
+    using MetricVector = std::vector<double>;
+#endif
+
     /// A given data entry. Can be for either job-related surveys or personal surveys.
     class Entry 
     {
@@ -48,24 +84,71 @@ namespace ewi
             Entry() = delete;
             Entry(
                     std::chrono::year_month_day date,
-                    std::string const& notes,
-                    std::vector<double> const& metrics
+                    std::string notes,
+                    std::span<double const> metrics
+            ) noexcept
+                : d_date(date), d_notes(std::move(notes)), d_metrics(metrics.begin(), metrics.end()) {}
+            /// Takes ownership of the metrics. Pass rvalues (ex. `std::move(notes)`) to
+            /// create the Entry without copying either buffer.
+            Entry(
+                    std::chrono::year_month_day date,
+                    std::string notes,
+                    MetricVector metrics
             ) noexcept
                 : d_date(date), d_notes(std::move(notes)), d_metrics(std::move(metrics)) {}
 
             inline auto date() const noexcept -> std::chrono::year_month_day const& { return d_date; }
             inline auto notes() const noexcept -> std::string const& { return d_notes; }
-            inline auto metrics() const noexcept -> std::vector<double> const& { return d_metrics; }
+            inline auto metrics() const noexcept -> MetricVector const& { return d_metrics; }
 
         private:
             std::chrono::year_month_day d_date;
             std::string d_notes;
-            std::vector<double> d_metrics;      
+            MetricVector d_metrics;
     };
     inline auto operator<=> (Entry const& a, Entry const& b) noexcept { return a.date() <=> b.date(); }  // The dates are equal.
     auto operator==(Entry const& a, Entry const& b) noexcept -> bool;  // all data members are equal.
     /// Output the Entry on a single line. To do so, the notes string is flattened,
     /// replacing newline characters with a symbol that doesn't break the line.
     auto operator<<(std::ostream& os, Entry const& e) noexcept -> std::ostream&;
+
+    /// A non-owning view of an Entry's data. Records store their Entries' members apart
+    /// from one another (ex. notes are kept out-of-line), so they hand out views rather
+    /// than references to `Entry` objects.
+    ///
+    /// A view is invalidated by any modification of the object it refers to.
+    class EntryView
+    {
+        public:
+            // CONSTRUCTORS
+            EntryView() = delete;
+            EntryView(
+                    std::chrono::year_month_day date,
+                    std::string_view notes,
+                    std::span<double const> metrics
+            ) noexcept
+                : d_date(date), d_notes(notes), d_metrics(metrics) {}
+            /// Views an existing Entry.
+            EntryView(Entry const& e) noexcept
+                : d_date(e.date()), d_notes(e.notes()), d_metrics(e.metrics()) {}
+
+            inline auto date() const noexcept -> std::chrono::year_month_day const& { return d_date; }
+            inline auto notes() const noexcept -> std::string_view { return d_notes; }
+            inline auto metrics() const noexcept -> std::span<double const> { return d_metrics; }
+            /// Copies the viewed data into an owning Entry.
+            inline auto to_entry() const -> Entry
+            {
+                return Entry(d_date, std::string(d_notes), d_metrics);
+            }
+
+        private:
+            std::chrono::year_month_day d_date;
+            std::string_view d_notes;
+            std::span<double const> d_metrics;
+    };
+    inline auto operator<=> (EntryView const& a, EntryView const& b) noexcept { return a.date() <=> b.date(); }  // The dates are equal.
+    auto operator==(EntryView const& a, EntryView const& b) noexcept -> bool;  // all viewed data are equal.
+    /// Output the viewed Entry in the same format as `operator<<(std::ostream&, Entry const&)`.
+    auto operator<<(std::ostream& os, EntryView const& e) noexcept -> std::ostream&;
 } // namespace ewi
 #endif // INCLUDED_EWI_ENTRY
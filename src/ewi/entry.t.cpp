@@ -27,7 +27,7 @@
 #include <vector>
 
 using Date = std::chrono::year_month_day;
-using ewi::Entry;
+using ewi::Entry, ewi::EntryView;
 
 void date_comp_test() 
 {    
@@ -77,8 +77,23 @@ void equal_comp_test()
     assert((b != c) && (a != c));
 }
 
+void view_test()
+{
+    using namespace std::chrono;
+    constexpr auto date = Date(2024y, std::chrono::October, 23d);
+    Entry a(date, "Some\nnotes", std::vector<double> {0., 0.1});
+    Entry b(date + std::chrono::months(1), "", std::vector<double> {0.});
+
+    EntryView view { a };
+    assert(view == a && view != b);
+    assert(view < b);
+    assert(view.notes() == "Some\nnotes" && view.metrics().size() == 2);
+    assert(view.to_entry() == a);
+}
+
 int main() 
 {
     date_comp_test();
     equal_comp_test();
+    view_test();
 }
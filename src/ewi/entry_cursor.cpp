@@ -0,0 +1,102 @@
+// entry_cursor.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "entry_cursor.hpp"
+//- STL
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <ewi/employee_record.hpp>
+
+
+using cpperrors::Exception;
+using IO = ewi::EmployeeRecordIOUtils;
+namespace ewi
+{
+    auto EntryFilter::accepts(std::string_view job_id, RecordType rec_type) const noexcept -> bool
+    {
+        if (type && *type != rec_type)
+            return false;
+        if (job && job->formal() != job_id)
+            return false;
+        return true;
+    }
+
+    EntryCursor::EntryCursor(std::string const& path, EntryFilter filter)
+        : d_filter{ std::move(filter) }, d_employee{ read_employee(path) }
+    {}
+
+    auto EntryCursor::read_employee(std::string const& path) -> Employee
+    {
+        d_file.open(path);
+        if (!d_file.is_open())
+            throw Exception("Could not open file: " + path);
+        if (IO::is_binary_record(path))
+            throw Exception("EntryCursor reads text record files only: " + path);
+        if (!read_line())
+            throw Exception("Incorrect format: missing employee line.");
+        std::string_view line { d_line };
+        return IO::parse_employee(line);
+    }
+
+    auto EntryCursor::read_line() -> bool
+    {
+        if (!std::getline(d_file, d_line))
+        {
+            if (d_file.bad())
+                throw Exception("Read Error.");
+            return false;
+        }
+        if (!d_line.empty() && d_line.back() == '\r')
+            d_line.pop_back();
+        return true;
+    }
+
+    auto EntryCursor::next() -> std::optional<CursorEntry>
+    {
+        while (!d_done && read_line())
+        {
+            std::string_view line { d_line };
+            IO::seek_nonws(line);
+            if (line.empty())
+            {
+                // Blank lines precede the Entries; the first one after them ends the
+                // record (see `EmployeeRecordIOUtils::import_record`).
+                if (d_in_entries)
+                    d_done = true;
+                continue;
+            }
+            d_in_entries = true;
+
+            auto job = IO::parse_job(line);
+            auto type = IO::parse_recordtype(line);
+            if (!d_filter.accepts(job, type))
+                continue;
+            auto date = IO::parse_date(line);
+            auto notes = IO::parse_notes(line);
+            auto metrics = IO::parse_metrics(line);
+            return CursorEntry{ JobID{ std::string(job) }, type, Entry(date, std::move(notes), std::move(metrics)) };
+        }
+        d_done = true;
+        return std::nullopt;
+    }
+} // namespace ewi
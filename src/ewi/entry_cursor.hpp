@@ -0,0 +1,128 @@
+// entry_cursor.hpp
+/// A single-pass reader over the Entries of an employee record file. Useful when a full
+/// `EmployeeRecord` isn't needed (ex. counting entries or inspecting one job).
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_EWI_ENTRY_CURSOR
+#define INCLUDED_EWI_ENTRY_CURSOR
+
+#ifndef INCLUDED_EWI_EMPLOYEE_RECORD
+#include <ewi/employee_record.hpp>
+#endif
+
+#ifndef INCLUDED_STD_FSTREAM
+#include <fstream>
+#define INCLUDED_STD_FSTREAM
+#endif
+
+#ifndef INCLUDED_STD_OPTIONAL
+#include <optional>
+#define INCLUDED_STD_OPTIONAL
+#endif
+
+#ifndef INCLUDED_STD_STRING
+#include <string>
+#define INCLUDED_STD_STRING
+#endif
+
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
+#ifndef INCLUDED_STD_UTILITY
+#include <utility>
+#define INCLUDED_STD_UTILITY
+#endif
+
+namespace ewi
+{
+    /// Selects which lines of a record file an `EntryCursor` decodes. An empty member
+    /// matches everything.
+    struct EntryFilter
+    {
+        std::optional<JobID> job {};
+        std::optional<RecordType> type {};
+
+        auto accepts(std::string_view job_id, RecordType rec_type) const noexcept -> bool;
+    };
+
+    /// An Entry read by an `EntryCursor` along with the Record it belongs to.
+    struct CursorEntry
+    {
+        JobID job;
+        RecordType type;
+        Entry entry;
+    };
+
+    /// Reads the Entries of a text record file (see `EmployeeRecordIOUtils::export_record`)
+    /// one at a time, in file order.
+    ///
+    /// Only one line is held in memory at a time, so memory use does not depend on the
+    /// file's size. Lines rejected by the filter are skipped after reading the JobID and
+    /// RecordType tokens; their dates, notes, and metrics are never decoded.
+    ///
+    /// Example:
+    ///
+    /// ```cpp
+    /// EntryCursor cursor { path, EntryFilter{ .job=JobID{"0260"} } };
+    /// while (auto item = cursor.next())
+    ///     process(item->type, item->entry);
+    /// ```
+    class EntryCursor
+    {
+        public:
+            // CONSTRUCTORS
+            EntryCursor() = delete;
+            /// Opens the file and reads the Employee line. Throws an exception if the
+            /// file cannot be opened.
+            explicit EntryCursor(std::string const& path, EntryFilter filter={});
+
+            // ACCESSORS
+            inline auto employee() const noexcept -> Employee const& { return d_employee; }
+
+            // MANIPULATORS
+
+            /// Reads the next Entry accepted by the filter. Returns `std::nullopt` once the
+            /// record is exhausted. Throws an exception if the line is ill-formatted.
+            auto next() -> std::optional<CursorEntry>;
+        private:
+            /// Reads the next line into `d_line`, stripping a trailing carriage return.
+            auto read_line() -> bool;
+            /// Opens the file and parses its first line. Called during construction.
+            auto read_employee(std::string const& path) -> Employee;
+
+            std::ifstream d_file;
+            std::string d_line {};
+            EntryFilter d_filter;
+            Employee d_employee;
+            bool d_in_entries { false };
+            bool d_done { false };
+    };
+
+    /// Calls `visitor(JobID const&, RecordType, Entry const&)` on each Entry of the file
+    /// accepted by the filter. Returns the Employee the file belongs to.
+    template<typename Visitor>
+    auto for_each_entry(std::string const& path, EntryFilter const& filter, Visitor&& visitor) -> Employee
+    {
+        EntryCursor cursor { path, filter };
+        while (auto item = cursor.next())
+            visitor(std::as_const(item->job), item->type, std::as_const(item->entry));
+        return cursor.employee();
+    }
+} // namespace ewi
+#endif // INCLUDED_EWI_ENTRY_CURSOR
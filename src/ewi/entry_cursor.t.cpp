@@ -0,0 +1,140 @@
+// entry_cursor.t.cpp
+// EntryCursor Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "entry_cursor.hpp"
+//- STL
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <ewi/employee_record.hpp>
+
+using namespace ewi;
+using namespace std::chrono_literals;
+
+void test_full_scan();
+void test_filtering();
+void test_blank_record();
+
+int main()
+{
+    try {
+        test_full_scan();
+        test_filtering();
+        test_blank_record();
+    } catch (cpperrors::Exception const& e) {
+        std::cerr << e.report(true) << "\n";
+        throw;
+    }
+}
+//--------------------------------------------------------------------------------------------------
+namespace
+{
+    Employee const PERSON { EmployeeID{ "00777" }, "Bugs Bunny" };
+    std::string const PATH { "bugs_record.txt" };
+
+    auto make_record() -> EmployeeRecord
+    {
+        EmployeeRecord rec { PERSON };
+        for (auto d : { 1d, 2d, 3d, 4d })
+        {
+            auto date = 2024y / std::chrono::March / d;
+            rec.add(JobID{ "1940" }, RecordType::Technical, Entry(date, "What's up,\n\"Doc\"?", std::vector<double>{ 1., 2. }));
+            rec.add(JobID{ "1940" }, RecordType::Personal, Entry(date, "", std::vector<double>{ 3. }));
+        }
+        for (auto d : { 5d, 6d })
+            rec.add(JobID{ "1938" }, RecordType::Technical, Entry(2024y / std::chrono::March / d, "Carrots", std::vector<double>{ 4., 5., 6. }));
+        return rec;
+    }
+}
+
+/// An unfiltered cursor visits every Entry exactly once and reproduces the record.
+void test_full_scan()
+{
+    auto rec = make_record();
+    EmployeeRecordIOUtils::export_record(rec, PATH);
+
+    EmployeeRecord rebuilt { PERSON };
+    int count {};
+    auto employee = for_each_entry(PATH, {}, [&](JobID const& job, RecordType type, Entry const& entry) {
+        rebuilt.add(job, type, entry);
+        ++count;
+    });
+    assert(employee == PERSON);
+    assert(count == 10);
+    assert(rebuilt == rec);
+    assert(rebuilt == EmployeeRecordIOUtils::import_record(PATH));
+
+    // An exhausted cursor stays exhausted.
+    EntryCursor cursor { PATH };
+    while (cursor.next()) {}
+    assert(!cursor.next());
+}
+
+/// Filters restrict the cursor to one job and/or record type.
+void test_filtering()
+{
+    std::map<std::string, int> counts {};
+    for_each_entry(PATH, EntryFilter{ .job=JobID{"1940"} }, [&](JobID const& job, RecordType, Entry const&) {
+        ++counts[job.formal()];
+    });
+    assert(counts.size() == 1 && counts["1940"] == 8);
+
+    EntryCursor cursor { PATH, EntryFilter{ .type=RecordType::Technical } };
+    int technical {};
+    while (auto item = cursor.next())
+    {
+        assert(item->type == RecordType::Technical);
+        ++technical;
+    }
+    assert(technical == 6);
+
+    EntryFilter both { .job=JobID{"1938"}, .type=RecordType::Technical };
+    EntryCursor narrow { PATH, both };
+    auto first = narrow.next();
+    assert(first && first->job == JobID{"1938"});
+    auto const rec = make_record();
+    assert(first->entry == *rec.get(JobID{"1938"}).technical.get(2024y/std::chrono::March/5d));
+    assert(narrow.next() && !narrow.next());
+
+    EntryCursor none { PATH, EntryFilter{ .job=JobID{"0000"} } };
+    assert(!none.next());
+}
+
+/// A record with no entries yields the employee and nothing else.
+void test_blank_record()
+{
+    std::string const path { "bugs_blank.txt" };
+    EmployeeRecordIOUtils::export_record(EmployeeRecord{ PERSON }, path);
+    EntryCursor cursor { path };
+    assert(cursor.employee() == PERSON);
+    assert(!cursor.next());
+
+    bool threw { false };
+    try {
+        EntryCursor missing { "no_such_record.txt" };
+    } catch (cpperrors::Exception const&) {
+        threw = true;
+    }
+    assert(threw);
+}
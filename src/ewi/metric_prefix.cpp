@@ -0,0 +1,118 @@
+// metric_prefix.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "metric_prefix.hpp"
+//- STL
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+
+namespace ewi
+{
+    void MetricPrefixSums::summarize(int first, int last, std::span<double> mean, std::span<double> variance) const noexcept
+    {
+        assert(0 <= first && first <= last && last < d_rows);
+        assert(static_cast<int>(mean.size()) >= d_dim && static_cast<int>(variance.size()) >= d_dim);
+        auto const dim = static_cast<std::size_t>(d_dim);
+        auto const lo = static_cast<std::size_t>(first) * dim;
+        auto const hi = static_cast<std::size_t>(last + 1) * dim;
+        double const count = last - first + 1;
+        for (std::size_t col {0}; col < dim; ++col)
+        {
+            double const sum = d_sums[hi + col] - d_sums[lo + col];
+            double const squares = d_squares[hi + col] - d_squares[lo + col];
+            double const shifted_mean = sum / count;
+            mean[col] = shifted_mean + d_shift[col];
+            // Rounding can leave a tiny negative value for constant columns.
+            variance[col] = std::max(0., squares / count - shifted_mean * shifted_mean);
+        }
+    }
+
+    void MetricPrefixSums::mean(int first, int last, std::span<double> mean) const noexcept
+    {
+        assert(0 <= first && first <= last && last < d_rows);
+        assert(static_cast<int>(mean.size()) >= d_dim);
+        auto const dim = static_cast<std::size_t>(d_dim);
+        auto const lo = static_cast<std::size_t>(first) * dim;
+        auto const hi = static_cast<std::size_t>(last + 1) * dim;
+        double const count = last - first + 1;
+        for (std::size_t col {0}; col < dim; ++col)
+            mean[col] = (d_sums[hi + col] - d_sums[lo + col]) / count + d_shift[col];
+    }
+
+    void MetricPrefixSums::extend(std::span<double const> metrics, int dim)
+    {
+        if (dim != d_dim)
+            clear();
+        if (dim == 0)
+            return;
+        auto const ncols = static_cast<std::size_t>(dim);
+        auto const total = static_cast<int>(metrics.size() / ncols);
+        if (total <= d_rows)
+            return;
+        if (d_rows == 0)
+        {
+            d_dim = dim;
+            d_shift.assign(metrics.begin(), metrics.begin() + dim);
+            d_sums.assign(ncols, 0.);
+            d_squares.assign(ncols, 0.);
+        }
+        d_sums.resize((static_cast<std::size_t>(total) + 1) * ncols);
+        d_squares.resize((static_cast<std::size_t>(total) + 1) * ncols);
+        for (auto row = static_cast<std::size_t>(d_rows); row < static_cast<std::size_t>(total); ++row)
+        {
+            double const* values = metrics.data() + row * ncols;
+            double const* prev_sums = d_sums.data() + row * ncols;
+            double const* prev_squares = d_squares.data() + row * ncols;
+            double* sums = d_sums.data() + (row + 1) * ncols;
+            double* squares = d_squares.data() + (row + 1) * ncols;
+            for (std::size_t col {0}; col < ncols; ++col)
+            {
+                double const x = values[col] - d_shift[col];
+                sums[col] = prev_sums[col] + x;
+                squares[col] = prev_squares[col] + x * x;
+            }
+        }
+        d_rows = total;
+    }
+
+    void MetricPrefixSums::truncate(int rows) noexcept
+    {
+        if (rows >= d_rows)
+            return;
+        if (rows <= 0) {
+            clear();
+            return;
+        }
+        d_rows = rows;
+        auto const kept = (static_cast<std::size_t>(rows) + 1) * static_cast<std::size_t>(d_dim);
+        d_sums.resize(kept);
+        d_squares.resize(kept);
+    }
+
+    void MetricPrefixSums::clear() noexcept
+    {
+        d_sums.clear();
+        d_squares.clear();
+        d_shift.clear();
+        d_rows = 0;
+        d_dim = 0;
+    }
+} // namespace ewi
@@ -0,0 +1,108 @@
+// metric_prefix.hpp
+/// Cumulative sums over the rows of a row-major metric block, for constant-time range
+/// statistics.
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_EWI_METRIC_PREFIX
+#define INCLUDED_EWI_METRIC_PREFIX
+
+#ifndef INCLUDED_STD_MEMORY_RESOURCE
+#include <memory_resource>
+#define INCLUDED_STD_MEMORY_RESOURCE
+#endif
+
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
+#ifndef INCLUDED_STD_UTILITY
+#include <utility>
+#define INCLUDED_STD_UTILITY
+#endif
+
+#ifndef INCLUDED_STD_VECTOR
+#include <vector>
+#define INCLUDED_STD_VECTOR
+#endif
+
+namespace ewi
+{
+    /// Per-column running sums and sums of squares of a metric block (one row per Entry).
+    ///
+    /// The sums cover the block's first `rows()` rows. Appended rows are folded in by
+    /// `extend`, while a change to row `i` only requires dropping the sums from `i` on
+    /// (`truncate`); the next `extend` recomputes them. The mean and variance of any run
+    /// of covered rows then take one subtraction per column.
+    ///
+    /// Values are summed relative to the first row's values, which keeps the variance
+    /// free of cancellation error when a metric's spread is small next to its magnitude.
+    ///
+    /// The sums are allocated from the allocator's memory resource. As with the `std::pmr`
+    /// containers, copies use the default resource unless one is passed, and assignment
+    /// keeps the target's resource.
+    class MetricPrefixSums
+    {
+        public:
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            // CONSTRUCTORS
+            MetricPrefixSums() = default;
+            /// Creates empty sums allocated from `alloc`.
+            explicit MetricPrefixSums(allocator_type alloc)
+                : d_sums{ alloc }, d_squares{ alloc }, d_shift{ alloc } {}
+            MetricPrefixSums(MetricPrefixSums const& other, allocator_type alloc)
+                : d_sums{ other.d_sums, alloc }, d_squares{ other.d_squares, alloc },
+                  d_shift{ other.d_shift, alloc }, d_rows{ other.d_rows }, d_dim{ other.d_dim } {}
+            MetricPrefixSums(MetricPrefixSums&& other, allocator_type alloc)
+                : d_sums{ std::move(other.d_sums), alloc }, d_squares{ std::move(other.d_squares), alloc },
+                  d_shift{ std::move(other.d_shift), alloc }, d_rows{ other.d_rows }, d_dim{ other.d_dim } {}
+
+            // ACCESSORS
+
+            /// Query the allocator the sums are allocated from.
+            inline auto get_allocator() const noexcept -> allocator_type { return d_sums.get_allocator(); }
+            /// Query how many metrics each row holds.
+            inline auto dim() const noexcept -> int { return d_dim; }
+            /// Query how many leading rows the sums cover.
+            inline auto rows() const noexcept -> int { return d_rows; }
+            /// Writes the per-column mean and population variance of rows `first` through
+            /// `last` (inclusive) to the given spans, which must hold `dim()` values each.
+            ///
+            /// Precondition: `0 <= first <= last < rows()`.
+            void summarize(int first, int last, std::span<double> mean, std::span<double> variance) const noexcept;
+            /// As above, for the means alone.
+            void mean(int first, int last, std::span<double> mean) const noexcept;
+
+            // MANIPULATORS
+
+            /// Extends the sums to cover every row of `metrics`, a row-major block with
+            /// `dim` columns whose first `rows()` rows are unchanged since they were summed.
+            void extend(std::span<double const> metrics, int dim);
+            /// Drops the sums of rows `rows` and later. Does nothing if fewer rows are
+            /// covered.
+            void truncate(int rows) noexcept;
+            void clear() noexcept;
+        private:
+            std::pmr::vector<double> d_sums {};     // (rows + 1) x dim; row r sums rows [0, r)
+            std::pmr::vector<double> d_squares {};  // likewise, for squared values
+            std::pmr::vector<double> d_shift {};    // first row's values
+            int d_rows {};
+            int d_dim {};
+    };
+} // namespace ewi
+#endif // INCLUDED_EWI_METRIC_PREFIX
@@ -0,0 +1,120 @@
+// metric_prefix.t.cpp
+// MetricPrefixSums Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "metric_prefix.hpp"
+//- STL
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using ewi::MetricPrefixSums;
+
+void test_summaries();
+void test_truncate();
+
+int main()
+{
+    test_summaries();
+    test_truncate();
+}
+//--------------------------------------------------------------------------------------------------
+namespace
+{
+    constexpr int DIM { 3 };
+
+    auto gen_block(int rows, unsigned seed) -> std::vector<double>
+    {
+        std::mt19937 gen { seed };
+        std::uniform_int_distribution<int> value { 0, 10 };
+        std::vector<double> block {};
+        for (int i {0}; i < rows * DIM; ++i)
+            block.push_back(value(gen) * 0.5 + ((i % DIM == 2) ? 1e6 : 0.));  // column 2 sits far from 0
+        return block;
+    }
+
+    /// Compares every range of rows with a two-pass computation.
+    void check(MetricPrefixSums const& sums, std::vector<double> const& block)
+    {
+        std::vector<double> mean(DIM), variance(DIM);
+        for (int first {0}; first < sums.rows(); ++first)
+            for (int last { first }; last < sums.rows(); ++last)
+            {
+                sums.summarize(first, last, mean, variance);
+                std::vector<double> mean_only(DIM);
+                sums.mean(first, last, mean_only);
+                assert(mean_only == mean);
+                double const count = last - first + 1;
+                for (int col {0}; col < DIM; ++col)
+                {
+                    double expected_mean {}, expected_var {};
+                    for (int row { first }; row <= last; ++row)
+                        expected_mean += block[row * DIM + col];
+                    expected_mean /= count;
+                    for (int row { first }; row <= last; ++row)
+                        expected_var += std::pow(block[row * DIM + col] - expected_mean, 2);
+                    expected_var /= count;
+                    assert(std::abs(mean[col] - expected_mean) < 1e-9);
+                    assert(std::abs(variance[col] - expected_var) < 1e-9);
+                }
+            }
+    }
+}
+
+/// Sums extended one row at a time match sums built in one pass.
+void test_summaries()
+{
+    auto const block = gen_block(40, 1);
+    MetricPrefixSums whole {};
+    whole.extend(block, DIM);
+    assert(whole.rows() == 40 && whole.dim() == DIM);
+    check(whole, block);
+
+    MetricPrefixSums stepwise {};
+    for (std::size_t rows {1}; rows <= 40; ++rows)
+        stepwise.extend(std::span{ block }.first(rows * DIM), DIM);
+    check(stepwise, block);
+}
+
+/// Changed rows are recomputed once the sums are truncated before them.
+void test_truncate()
+{
+    auto block = gen_block(30, 2);
+    MetricPrefixSums sums {};
+    sums.extend(block, DIM);
+
+    block[15 * DIM] = 100.;
+    sums.truncate(15);
+    assert(sums.rows() == 15);
+    sums.extend(block, DIM);
+    check(sums, block);
+
+    // A new first row resets the reference values.
+    block.insert(block.begin(), { -4., 2., 1e6 + 3. });
+    sums.truncate(0);
+    assert(sums.rows() == 0);
+    sums.extend(block, DIM);
+    check(sums, block);
+
+    sums.truncate(100);  // nothing to drop
+    assert(sums.rows() == 31);
+    sums.extend(std::vector<double>{ 1., 2. }, 2);  // new dimension starts over
+    assert(sums.rows() == 1 && sums.dim() == 2);
+    sums.clear();
+    assert(sums.rows() == 0 && sums.dim() == 0);
+}
@@ -20,16 +20,19 @@
 // #include <iostream>
 #include <functional>
 #include <optional>
+#include <span>
 #include <vector>
 //- Third-party
 #include <Eigen/Eigen>
 #include <matplot/matplot.h>
+//- In-house
+#include <ewi/record.hpp>
 
 
 namespace ewi
 {
 
-    auto get_means(Eigen::MatrixXd const& metrics, bool colwise) -> Eigen::VectorXd
+    auto get_means(Eigen::Ref<MetricMatrix const> const& metrics, bool colwise) -> Eigen::VectorXd
     {
        assert(metrics.size() > 0);
        if (colwise)
@@ -38,7 +41,7 @@ namespace ewi
            return metrics.rowwise().mean();
     }
 
-    auto calculate_ewi(Eigen::VectorXd const& local_means, Eigen::VectorXd const& global_means) -> Eigen::VectorXd
+    auto calculate_ewi(Eigen::Ref<Eigen::VectorXd const> const& local_means, Eigen::Ref<Eigen::VectorXd const> const& global_means) -> Eigen::VectorXd
     {
         assert(local_means.size() > 0);
         assert(local_means.rows() == global_means.rows() && local_means.cols() == global_means.cols());
@@ -130,6 +133,26 @@ namespace ewi
         return m;
     }
 
+    auto to_eigen(MetricRows const& data) -> Eigen::MatrixXd
+    {
+        return as_eigen(data);
+    }
+
+    auto as_eigen(MetricRows const& data) noexcept -> Eigen::Map<MetricMatrix const>
+    {
+        return Eigen::Map<MetricMatrix const>(data.data().data(), data.rows(), data.cols());
+    }
+
+    auto as_eigen(std::span<double const> data) noexcept -> Eigen::Map<Eigen::VectorXd const>
+    {
+        return Eigen::Map<Eigen::VectorXd const>(data.data(), static_cast<Eigen::Index>(data.size()));
+    }
+
+    auto as_eigen(PeriodSummaries const& data) noexcept -> Eigen::Map<MetricMatrix const>
+    {
+        return Eigen::Map<MetricMatrix const>(data.means.data(), data.size(), data.dim);
+    }
+
     auto plot_ewi(std::vector<double> const& ewi_vals, PlotCustomization const& opts, std::optional<double> personal_ewi) -> bool
     {
         namespace mpl = matplot;
@@ -29,6 +29,11 @@
 #define INCLUDED_STD_OPTIONAL
 #endif
 
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
 #ifndef INCLUDED_STD_STRING
 #include <string>
 #define INCLUDED_STD_STRING
@@ -39,10 +44,20 @@
 #define INCLUDED_EIGEN
 #endif
 
+#ifndef INCLUDED_EWI_RECORD
+#include <ewi/record.hpp>
+#endif
+
 namespace ewi
 {
+    /// Metrics laid out as a Record stores them: one row per Entry.
+    using MetricMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
     /// Return the means of the given vector. Taken column-eise by default
-    auto get_means(Eigen::MatrixXd const& metrics, bool colwise=true) -> Eigen::VectorXd;
+    ///
+    /// Row-major matrices and maps (see `as_eigen`) are read in place; a column-major
+    /// argument is copied into a row-major temporary first.
+    auto get_means(Eigen::Ref<MetricMatrix const> const& metrics, bool colwise=true) -> Eigen::VectorXd;
 
     /// Calculate the Employee Workload Index (EWI).
     /// Produces the numeric comparison between each metric and its global mean value.
@@ -58,7 +73,7 @@ namespace ewi
     ///     average of about 1. Since the idea is to give a visual indication of workload, this
     ///     conversion does not affect the efficacy of the data; instead, it aids in
     ///     communicating the desired information.
-    auto calculate_ewi(Eigen::VectorXd const& local_means, Eigen::VectorXd const& global_means ) -> Eigen::VectorXd;
+    auto calculate_ewi(Eigen::Ref<Eigen::VectorXd const> const& local_means, Eigen::Ref<Eigen::VectorXd const> const& global_means) -> Eigen::VectorXd;
     
     /// Calculate EWI for Personal Surveys
     /// 
@@ -85,6 +100,15 @@ namespace ewi
     /// Convert to Eigen
     auto to_eigen(std::vector<double>& data) -> Eigen::VectorXd;
     auto to_eigen(std::vector<std::reference_wrapper<std::vector<double>>> const& data) -> Eigen::MatrixXd;
+    /// Copies the viewed block in one pass (see `Record::metrics`).
+    auto to_eigen(MetricRows const& data) -> Eigen::MatrixXd;
+
+    /// Views the data as an Eigen object. No data is copied, so the result is invalidated
+    /// along with its argument (ex. by modifying the Record a `MetricRows` refers to).
+    auto as_eigen(MetricRows const& data) noexcept -> Eigen::Map<MetricMatrix const>;
+    auto as_eigen(std::span<double const> data) noexcept -> Eigen::Map<Eigen::VectorXd const>;
+    /// One row of metric means per period (see `Record::rollup`).
+    auto as_eigen(PeriodSummaries const& data) noexcept -> Eigen::Map<MetricMatrix const>;
 
 
     /// A simple data structure for passing in plot
@@ -20,6 +20,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <span>
 //- Third-party
 #include <Eigen/Eigen>
 
@@ -67,6 +68,24 @@ void test_to_eigen()
 
     auto test_m = to_eigen(DATA);
     assert(test_m.isApprox(m));
+
+    std::vector<double> block {};
+    for (int i {0}; i < 4; ++i)
+        block.insert(block.end(), METRICS.begin(), METRICS.end());
+    assert(to_eigen(MetricRows{ block.data(), 4, 4 }).isApprox(m));
+
+    // Maps read the block in place.
+    auto mapped = as_eigen(MetricRows{ block.data(), 4, 4 });
+    assert(mapped.data() == block.data() && mapped.isApprox(m));
+    assert(get_means(mapped).isApprox(get_means(m)));
+    auto vec = as_eigen(std::span<double const>{ METRICS });
+    assert(vec.data() == METRICS.data() && vec.size() == 4);
+    assert(calculate_ewi(vec, vec).isApprox(Eigen::VectorXd::Ones(4)));
+
+    // Rolled-up means map with one row per period.
+    PeriodSummaries periods { .starts={ {}, {} }, .counts={ 1, 1 }, .means=block, .dim=8 };
+    auto per_period = as_eigen(periods);
+    assert(per_period.rows() == 2 && per_period.cols() == 8 && per_period.data() == periods.means.data());
 }
 
 void test_mean_calc()
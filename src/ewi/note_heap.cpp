@@ -0,0 +1,41 @@
+// note_heap.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "note_heap.hpp"
+//- STL
+#include <cstdint>
+#include <limits>
+#include <string_view>
+//- Third-party
+#include <cpperrors>
+
+
+using cpperrors::Exception;
+namespace ewi
+{
+    auto NoteHeap::add(std::string_view note) -> NoteHandle
+    {
+        if (note.empty())
+            return {};
+        constexpr std::size_t LIMIT { std::numeric_limits<std::uint32_t>::max() };
+        if (note.size() > LIMIT - d_buffer.size())
+            throw Exception("Note storage limit exceeded.");
+        NoteHandle handle { static_cast<std::uint32_t>(d_buffer.size()), static_cast<std::uint32_t>(note.size()) };
+        d_buffer.append(note);
+        return handle;
+    }
+} // namespace ewi
@@ -0,0 +1,111 @@
+// note_heap.hpp
+/// Out-of-line storage for Entry notes. Notes are rarely read (only when displayed or
+/// exported), so a Record keeps them in one contiguous buffer rather than beside each
+/// Entry's date and metrics.
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_EWI_NOTE_HEAP
+#define INCLUDED_EWI_NOTE_HEAP
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_CSTDINT
+#include <cstdint>
+#define INCLUDED_STD_CSTDINT
+#endif
+
+#ifndef INCLUDED_STD_MEMORY_RESOURCE
+#include <memory_resource>
+#define INCLUDED_STD_MEMORY_RESOURCE
+#endif
+
+#ifndef INCLUDED_STD_STRING
+#include <string>
+#define INCLUDED_STD_STRING
+#endif
+
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
+#ifndef INCLUDED_STD_UTILITY
+#include <utility>
+#define INCLUDED_STD_UTILITY
+#endif
+
+namespace ewi
+{
+    /// Locates a note within a `NoteHeap`. The default handle is the empty note, which
+    /// occupies no heap space.
+    struct NoteHandle
+    {
+        std::uint32_t offset {};
+        std::uint32_t length {};
+    };
+
+    /// An append-only buffer of notes addressed by `NoteHandle`s.
+    ///
+    /// Releasing a note only marks its bytes as garbage; owners reclaim space by
+    /// rebuilding the heap (ex. re-adding live notes to a fresh heap) once
+    /// `should_compact()` reports that most of it is garbage.
+    class NoteHeap
+    {
+        public:
+            // CONSTRUCTORS
+            NoteHeap() = default;
+            /// Creates an empty heap whose buffer is allocated from `resource`.
+            explicit NoteHeap(std::pmr::memory_resource* resource) : d_buffer{ resource } {}
+            /// Takes over `buffer`, whose notes the owner addresses with handles of its
+            /// own making (ex. from offsets recorded while filling it).
+            explicit NoteHeap(std::pmr::string buffer) noexcept : d_buffer{ std::move(buffer) } {}
+
+            /// Copies the note into the heap. Throws an exception if the heap would
+            /// exceed the handle's 4 GiB addressing limit.
+            auto add(std::string_view note) -> NoteHandle;
+            inline auto get(NoteHandle handle) const noexcept -> std::string_view
+            {
+                return std::string_view{ d_buffer }.substr(handle.offset, handle.length);
+            }
+            /// Marks the note's bytes as unused.
+            inline void release(NoteHandle handle) noexcept { d_garbage += handle.length; }
+
+            /// Query the memory resource the buffer is allocated from.
+            inline auto resource() const noexcept -> std::pmr::memory_resource*
+            {
+                return d_buffer.get_allocator().resource();
+            }
+            /// Query the heap's size in bytes, including garbage.
+            inline auto size() const noexcept -> std::size_t { return d_buffer.size(); }
+            inline auto garbage() const noexcept -> std::size_t { return d_garbage; }
+            /// Query if garbage makes up more than half of a non-trivial heap.
+            inline auto should_compact() const noexcept -> bool
+            {
+                return d_garbage > MIN_COMPACT_BYTES && d_garbage * 2 > d_buffer.size();
+            }
+            void reserve(std::size_t bytes) { d_buffer.reserve(bytes); }
+        private:
+            static constexpr std::size_t MIN_COMPACT_BYTES { 4096 };
+
+            std::pmr::string d_buffer {};
+            std::size_t d_garbage {};
+    };
+} // namespace ewi
+#endif // INCLUDED_EWI_NOTE_HEAP
@@ -0,0 +1,67 @@
+// note_heap.t.cpp
+// NoteHeap Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "note_heap.hpp"
+//- STL
+#include <cassert>
+#include <string>
+#include <vector>
+
+using ewi::NoteHeap, ewi::NoteHandle;
+
+void test_add_and_get();
+void test_garbage();
+
+int main()
+{
+    test_add_and_get();
+    test_garbage();
+}
+//--------------------------------------------------------------------------------------------------
+void test_add_and_get()
+{
+    NoteHeap heap {};
+    auto empty = heap.add("");
+    assert(empty.length == 0 && heap.size() == 0);
+    assert(heap.get(empty).empty() && heap.get(NoteHandle{}).empty());
+
+    auto first = heap.add("Multi-line\nnotes.");
+    auto second = heap.add("Second");
+    assert(heap.get(first) == "Multi-line\nnotes.");
+    assert(heap.get(second) == "Second");
+    assert(heap.size() == first.length + second.length);
+}
+
+void test_garbage()
+{
+    NoteHeap heap {};
+    std::vector<NoteHandle> handles {};
+    std::string const note (100, 'x');
+    for (int i {0}; i < 100; ++i)
+        handles.push_back(heap.add(note));
+    assert(!heap.should_compact());
+
+    for (int i {0}; i < 40; ++i)
+        heap.release(handles[i]);
+    assert(heap.garbage() == 4000 && !heap.should_compact());
+    for (int i {40}; i < 60; ++i)
+        heap.release(handles[i]);
+    assert(heap.should_compact());
+    // Released bytes stay readable until the owner rebuilds the heap.
+    assert(heap.get(handles[99]) == note);
+}
@@ -18,24 +18,30 @@
 #include "record.hpp"
 //- STL
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 //- Third-party
 #include <cpperrors>
 //- In-house
 #include "entry.hpp"
-#include <utils/padded_view.hpp>   // PaddedView
+#include "calendar_rollup.hpp"
+#include "day_index.hpp"
+#include "metric_prefix.hpp"
+#include "note_heap.hpp"
 
 
 // Helper Functions
 namespace
 {
-    constexpr inline int floored_avg(int a, int b)
-    {
-        return (a+b)/2;
-    }
+    /// Source of Record versions. Zero is reserved for default-constructed Records.
+    std::atomic<std::uint64_t> g_last_version {0};
 }
 namespace ewi
 {
@@ -55,43 +61,157 @@ namespace ewi
         return os;
     }
 /* Record */
-    Record::Record (std::vector<Entry>& entries)
-        : d_entries{ std::move(entries) }
+    Record::Record (std::pmr::memory_resource* resource)
+        : d_dates{ resource }, d_metrics{ resource }, d_note_handles{ resource },
+          d_notes{ resource }, d_index{ resource }, d_rollup{ resource }, d_prefix{ resource }
+    {
+    }
+
+    Record::Record (Record const& other, allocator_type alloc)
+        : Record(alloc.resource())
+    {
+        // Assignment keeps this Record's resource.
+        *this = other;
+    }
+
+    Record::Record (Record&& other, allocator_type alloc)
+        : Record(alloc.resource())
+    {
+        *this = std::move(other);
+    }
+
+    Record::Record (std::vector<Entry>& entries, std::pmr::memory_resource* resource)
+        : Record(resource)
     {
         /* Invariants
          * Each entry in a record must have a unique date and must have the
          * same number of metric elements as the other
          * entries.
          */
-        if (!d_entries.empty()) {
-           for (int i=0; i < static_cast<int>( d_entries.size() ) - 1; ++i){
-                if (!(d_entries[i+1].date() > d_entries[i].date()))
+        for (auto const& e: entries)
+            if (!e.date().ok())
+                throw Exception("Each entry must have a valid calendar date.");
+        if (!entries.empty()) {
+           for (int i=0; i < static_cast<int>( entries.size() ) - 1; ++i){
+                if (!(entries[i+1].date() > entries[i].date()))
                     throw Exception("Each entry must be a later date than the previous.");
-                if (d_entries[i+1].metrics().size() != d_entries[i].metrics().size())
+                if (entries[i+1].metrics().size() != entries[i].metrics().size())
                     throw Exception("Entry found with different number of numeric responses.");
            }
         }
+        std::size_t note_bytes {};
+        for (auto const& e: entries)
+            note_bytes += e.notes().size();
+        d_dim = entries.empty() ? 0 : static_cast<int>(entries[0].metrics().size());
+        d_dates.reserve(entries.size());
+        d_metrics.reserve(entries.size() * static_cast<std::size_t>(d_dim));
+        d_note_handles.reserve(entries.size());
+        d_notes.reserve(note_bytes);
+        for (auto const& e: entries)
+            insert_row(size(), e);
+        entries.clear();
+        touch();
+    }
+
+    Record::Record (RecordColumns&& columns, std::pmr::memory_resource* resource)
+        : Record(resource)
+    {
+        auto& [dates, metrics, dim, notes, note_offsets] = columns;
+        auto const rows = dates.size();
+        if (dim < 0 || metrics.size() != rows * static_cast<std::size_t>(dim))
+            throw Exception("Entry found with different number of numeric responses.");
+        if (note_offsets.size() != rows + 1 || note_offsets.front() != 0 || note_offsets.back() != notes.size())
+            throw Exception("Note offsets do not match the entries.");
+        for (std::size_t i {1}; i < rows; ++i)
+            if (DayIndex::sort_key(dates[i]) <= DayIndex::sort_key(dates[i - 1]))
+                throw Exception("Each entry must be a later date than the previous.");
+        for (auto date: dates)
+            if (!date.ok())
+                throw Exception("Each entry must have a valid calendar date.");
+        for (std::size_t i {0}; i < rows; ++i)
+            if (note_offsets[i + 1] < note_offsets[i])
+                throw Exception("Note offsets do not match the entries.");
+
+        // Moving into the members takes over buffers on the same resource and copies
+        // the rest.
+        d_dim = rows ? dim : 0;
+        d_dates = std::move(dates);
+        d_metrics = std::move(metrics);
+        d_notes = NoteHeap{ std::pmr::string{ std::move(notes), resource } };
+        d_note_handles.reserve(rows);
+        for (std::size_t i {0}; i < rows; ++i)
+        {
+            auto const length = note_offsets[i + 1] - note_offsets[i];
+            d_note_handles.push_back(length ? NoteHandle{ note_offsets[i], length } : NoteHandle{});
+        }
+        d_rollup.assign(d_dates, d_metrics, d_dim);
+        d_index.assign(d_dates);
+        touch();
+    }
+
+    auto Record::aggregate(std::span<DateRange const> ranges) const -> RangeMeans
+    {
+        auto const count = ranges.size();
+        std::vector<int> firsts(count), lasts(count);
+        // Bounds that arrive in date order (ex. consecutive weeks) are found in a single
+        // sweep, each search galloping from where the previous one ended. Sorting other
+        // batches costs more than it saves, so their bounds are searched independently.
+        auto sweep = [count](auto&& bound_of, auto&& key_of) -> bool {
+            for (std::size_t i {1}; i < count; ++i)
+                if (key_of(i) < key_of(i - 1))
+                    return false;
+            int hint {0};
+            for (std::size_t i {0}; i < count; ++i)
+                hint = bound_of(i, hint);
+            return true;
+        };
+        // A missing minimum sorts first; a missing maximum sorts last.
+        auto min_key = [&](std::size_t i) -> std::int64_t {
+            return ranges[i].min ? DayIndex::sort_key(*ranges[i].min) : std::numeric_limits<std::int64_t>::min();
+        };
+        auto max_key = [&](std::size_t i) -> std::int64_t {
+            return ranges[i].max ? DayIndex::sort_key(*ranges[i].max) : std::numeric_limits<std::int64_t>::max();
+        };
+
+        auto lower = [&](std::size_t i, int hint) -> int {
+            return firsts[i] = ranges[i].min ? d_index.lower_bound(*ranges[i].min, hint) : 0;
+        };
+        if (!sweep(lower, min_key))
+            for (std::size_t i {0}; i < count; ++i)
+                firsts[i] = ranges[i].min ? d_index.lower_bound(*ranges[i].min) : 0;
+
+        auto upper = [&](std::size_t i, int hint) -> int {
+            auto const bound = ranges[i].max ? d_index.upper_bound(*ranges[i].max, hint) : size();
+            lasts[i] = bound - 1;
+            return bound;
+        };
+        if (!sweep(upper, max_key))
+            for (std::size_t i {0}; i < count; ++i)
+                lasts[i] = (ranges[i].max ? d_index.upper_bound(*ranges[i].max) : size()) - 1;
+
+        if (d_prefix.rows() < size() || d_prefix.dim() != d_dim)
+            d_prefix.extend(d_metrics, d_dim);
+        RangeMeans out { .counts=std::vector<int>(count), .dim=metric_dim() };
+        auto const dim = static_cast<std::size_t>(out.dim);
+        out.means.resize(count * dim, std::numeric_limits<double>::quiet_NaN());
+        for (std::size_t i {0}; i < count; ++i)
+        {
+            out.counts[i] = std::max(0, lasts[i] - firsts[i] + 1);
+            if (out.counts[i] > 0 && out.dim > 0)
+                d_prefix.mean(firsts[i], lasts[i], std::span<double>{ out.means }.subspan(i * dim, dim));
+        }
+        return out;
     }
 
     auto Record::find(std::chrono::year_month_day date) const noexcept -> std::optional<int>
     {
-        auto idx = static_cast<int>(std::distance(
-                d_entries.begin(), 
-                std::find_if(
-                    d_entries.begin(), d_entries.end(), 
-                    [date](Entry const& e)-> bool { return e.date() == date; }
-                )
-        ));
-        if (idx == size())
-            return std::nullopt;
-        else 
-            return idx;
+        return d_index.find(date);
     }
 
     auto Record::find(DateRange date_range) const noexcept -> std::optional<IndexRange>
     {
         // Empty case
-        if (d_entries.empty())
+        if (d_dates.empty())
             return std::nullopt;
         // Handle single date case
         if (date_range.min && date_range.max && (*date_range.min == *date_range.max)) {
@@ -101,255 +221,368 @@ namespace ewi
             else
                 return IndexRange{idx, idx};
         }
-        // Use a PaddedView in order to treat
-        // all non-empty vectors as if there
-        // are at least three elements. This
-        // allows me to remove tedious edge
-        // case checks.
-        using utils::PaddedView;
-        PaddedView<Entry> entries {d_entries};
-        // Values for resultant output.
-        std::optional<int> index_min {};
-        std::optional<int> index_max {}; 
-
-        int global_min { 0 };  // padded container's left boundary
-        int global_max { static_cast<int>(entries.size() - 1)}; // padded container's right boundary
-        // Find the entries with dates greater than or
-        // equal to the minimum
-        if (!date_range.min)
-            index_min = global_min;
-        else {
-            // find index_min, the floor of the index range
-            std::chrono::year_month_day smallest_date = *date_range.min ;
-            int ss_min { global_min }; // search space left bound
-            int ss_max { global_max }; // search space right bound
-            // the index used to split the search space (in padded view).
-            int poll_idx { floored_avg(ss_min, ss_max) };  
-
-
-            // The following while-loop condition guarantees that the index used within the
-            // loop will always be within the container's extremes. Therefore, we use the
-            // PaddedView to allow a fake "off-by-one" error. The point being, instead of
-            // dealing with edge cases on the borders of the real vector, the PaddedView
-            // allows use to treat the borders as if they were non-border values; there's
-            // no special case that make the code harder to read.
-            //
-            // Condition: (poll_idx > ss_min && poll_idx < ss_max)
-            //
-            // Due to the chosen search space update method (non-overlapping), the poll
-            // index will always be biased toward the left.  Meaning, given
-            //
-            //     0 1 2 3 4
-            //
-            // if we start at 2 and search left, the new index to poll is (0 + 1)/2 -> 0.
-            // Searching right, the index would be (3 + 4)/2 -> 3.  As a result, in the
-            // case of only two elements, the smallest value greater than or equal to the
-            // minimum will always be found in one comparison. If the left element is
-            // greater than or equal to the target, that element is the answer. If not,
-            // there is no answer.
-            //
-            // Due to the left bias, technically the polling index would never exceed the
-            // ss_max, but I'm leaving the condition in for symmetry and future
-            // flexibility.
-            //
-            // What happens when we end with a search space with two elements on the left
-            // end of the global search space? For example, what if we have
-            //
-            //     0 1
-            //
-            // in the PaddedView reference frame? Well, the polling index would be 0 (the
-            // edge of the PaddedView) which is programmed to be the same as PaddedView[1]
-            // which is InternalVector[0]. In other words, we don't lose any information.
-            //
-            // The same logic can be applied to the right end of the search space:
-            //
-            //    3 4 
-            //    _   // poll_index
-            //
-            // `3` is ss_min, so the loop breaks. However, index 4 maps right back to index
-            // 3 because it's the end of the PaddedView, so no information is lost.
-            while (poll_idx > ss_min && poll_idx < ss_max) {
-                std::chrono::year_month_day poll_date = entries[poll_idx].date();
-                if (poll_date > smallest_date) {
-                    // search left half of search space to see if there is an even smaller
-                    // floor.
-                    if (entries[poll_idx - 1].date() >= smallest_date) {
-                        ss_max = poll_idx - 1;
-                        poll_idx = floored_avg(ss_min, ss_max);
-                    } else break;
-                } else if (poll_date < smallest_date) {
-                    // search to the right
-                    ss_min = poll_idx + 1;
-                    poll_idx = floored_avg(ss_min, ss_max);
-                } else break; // found exact match
-            }
-            if (poll_idx == global_min) { 
-                // NOTE: The following logic only works because of PaddedView's behavior in
-                // which PaddedView[0] just returns the first element of the wrapped
-                // vector.
-                if (entries[poll_idx].date() < smallest_date)
-                    index_min = std::nullopt;
-                else  
-                    index_min = 0;
-            } 
-            else if (poll_idx == global_max)
-            {
-                if (entries[poll_idx].date() < smallest_date)
-                    index_min = std::nullopt;
-                else
-                // padding adjustment
-                    index_min = poll_idx - 2;
-            }
-            else 
-                // padding adjustment
-                index_min = poll_idx-1;
-        }
-
-
-        // find index_max, the ceiling of the date_range.
-        if (!date_range.max)
-            index_max = global_max - 2; // adjust for padding
-        else {
-            std::chrono::year_month_day largest_date = *date_range.max ;
-            
-            int ss_min { global_min }; // search space left bound
-            int ss_max { global_max }; // search space right bound
-            int poll_idx { floored_avg(ss_min, ss_max) }; 
-            while (poll_idx > ss_min && poll_idx < ss_max) {
-                std::chrono::year_month_day poll_date = entries[poll_idx].date();
-                if (poll_date < largest_date) {
-                    // look to the right to see if we need
-                    // to search the right half of search space
-                    if (entries[poll_idx + 1].date() <= largest_date){
-                        ss_min = poll_idx + 1;
-                        poll_idx = floored_avg(ss_min, ss_max);
-                    } else break;
-                } else if (poll_date > largest_date) {
-                    // search to the left
-                    ss_max = poll_idx - 1;
-                    poll_idx = floored_avg(ss_min, ss_max);
-                } else break;
-                
-            }
-            // minimum > largest? Nothing there.
-            if (poll_idx == global_min) { 
-                if (entries[poll_idx].date() > largest_date)
-                    index_max = std::nullopt;
-                else  
-                    index_max = 0;
-            }
-            else if (poll_idx == global_max)
-            {
-                if (entries[poll_idx].date() > largest_date)
-                    index_max = std::nullopt;
-                else
-                    // Padding adjustment
-                    index_max = poll_idx - 2;
-            }
-            else 
-                index_max = poll_idx - 1;
-        }
-
-        if (!index_min || !index_max)
+        // Index of the first entry on or after the minimum and of the last entry on or
+        // before the maximum. An unbounded side extends to the Record's edge.
+        int const index_min { date_range.min ? d_index.lower_bound(*date_range.min) : 0 };
+        int const index_max { (date_range.max ? d_index.upper_bound(*date_range.max) : size()) - 1 };
+        if (index_min == size() || index_max < 0)
             return std::nullopt;
         else 
             return IndexRange{ index_min, index_max };
     }
 
-    auto Record::get(std::chrono::year_month_day date) const noexcept -> std::optional<std::reference_wrapper<Entry const>>
+    auto Record::get(std::chrono::year_month_day date) const noexcept -> std::optional<EntryView>
     {
         auto idx = find(date);
         if (!idx)
             return std::nullopt;
         else 
-            return d_entries[*idx]; // this copies!
+            return operator[](*idx);
     }
 
-    auto Record::get(DateRange const& dates) const noexcept -> std::optional<std::vector<std::reference_wrapper<Entry const>>>
+    auto Record::get(DateRange const& dates) const noexcept -> std::optional<EntryRange>
     {
         auto idxs = find(dates);
         if (!idxs)
             return std::nullopt;
-        std::vector<std::reference_wrapper<Entry const>> entries {};
-        for (int i { *(idxs->min) }; i <= *(idxs->max); ++i)
-            entries.push_back(operator[](i));
-        return entries;
+        // A reversed range (min > max) finds its bounds crossed; view nothing.
+        auto const first = begin() + *(idxs->min);
+        return EntryRange{ first, first + std::max(0, *(idxs->max) - *(idxs->min) + 1) };
     }
 
     auto Record::is_empty() const noexcept -> bool { return size() == 0; }
     
-    auto Record::metric_dim() const noexcept -> int { return is_empty() ? 0 : d_entries[0].metrics().size(); }
+    auto Record::metric_dim() const noexcept -> int { return is_empty() ? 0 : d_dim; }
     
-    auto Record::metrics(std::chrono::year_month_day date) const noexcept -> std::optional<std::reference_wrapper<std::vector<double>>>
+    auto Record::metrics(std::chrono::year_month_day date) const noexcept -> std::optional<std::span<double const>>
     {
-        auto test = metrics({date, date});
-        if (!test)
+        auto idx = find(date);
+        if (!idx)
             return std::nullopt;
-        else
-            return (*test)[0].get();
+        auto const row = static_cast<std::size_t>(*idx) * static_cast<std::size_t>(d_dim);
+        return std::span<double const>{ d_metrics.data() + row, static_cast<std::size_t>(d_dim) };
     }
 
-    auto Record::metrics(DateRange const& dates) const noexcept -> std::optional<std::vector<std::reference_wrapper<std::vector<double>>>>
+    auto Record::metrics(DateRange const& dates) const noexcept -> std::optional<MetricRows>
     {
-        auto entries = get(dates);
-        if (!entries)
+        auto idxs = find(dates);
+        if (!idxs)
             return std::nullopt;
-        std::vector<std::reference_wrapper<std::vector<double>>> metrics {};
-        /// The const on the metrics is cast away to be compatible with Eigen.
-        /// The assumption is that this method will never be used to modify metrics
-        /// directly.
-        for (Entry const& e : *entries)
-            metrics.push_back(std::ref(
-                        const_cast<std::vector<double>&>(e.metrics())
-            ));
-
-        return metrics;
+        auto const first = static_cast<std::ptrdiff_t>(*(idxs->min)) * d_dim;
+        return MetricRows{ d_metrics.data() + first, std::max(0, *(idxs->max) - *(idxs->min) + 1), d_dim };
+    }
+
+    auto Record::rollup(CalendarPeriod period, DateRange const& dates) const -> PeriodSummaries
+    {
+        return d_rollup.summarize(period, dates.min, dates.max);
     }
 
-    auto Record::size() const noexcept -> int { return static_cast<int>(d_entries.size()); }
+    auto Record::summarize(DateRange const& dates) const -> std::optional<MetricSummary>
+    {
+        auto idxs = find(dates);
+        if (!idxs || *(idxs->max) < *(idxs->min) || d_dim == 0)
+            return std::nullopt;
+        if (d_prefix.rows() < size() || d_prefix.dim() != d_dim)
+            d_prefix.extend(d_metrics, d_dim);
+        MetricSummary summary {
+            .count = *(idxs->max) - *(idxs->min) + 1,
+            .mean = std::vector<double>(static_cast<std::size_t>(d_dim)),
+            .variance = std::vector<double>(static_cast<std::size_t>(d_dim)),
+        };
+        d_prefix.summarize(*(idxs->min), *(idxs->max), summary.mean, summary.variance);
+        return summary;
+    }
+
+    auto Record::size() const noexcept -> int { return static_cast<int>(d_dates.size()); }
     
-    auto Record::operator[] (int idx) const -> Entry const& { return d_entries[idx]; }
+    auto Record::operator[] (int idx) const -> EntryView
+    {
+        auto const row = static_cast<std::size_t>(idx) * static_cast<std::size_t>(d_dim);
+        return EntryView{
+            d_dates[idx],
+            d_notes.get(d_note_handles[idx]),
+            std::span<double const>{ d_metrics.data() + row, static_cast<std::size_t>(d_dim) }
+        };
+    }
+
+    auto Record::operator== (Record const& rhs) const -> bool
+    {
+        return std::equal(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    auto Record::operator<=> (Record const& rhs) const -> std::strong_ordering
+    {
+        return std::lexicographical_compare_three_way(
+                d_dates.begin(), d_dates.end(), rhs.d_dates.begin(), rhs.d_dates.end());
+    }
 
     void Record::add(Entry const& entry)
     {
-        if (!d_entries.empty())
+        emplace(entry.date(), entry.notes(), entry.metrics());
+    }
+
+    void Record::emplace(std::chrono::year_month_day date, std::string_view notes, std::span<double const> metrics)
+    {
+        if (!date.ok())
+            throw Exception("Could not add entry to record; Date is not a valid calendar date.");
+        if (!d_dates.empty())
         {
-            Entry prev = d_entries.back();
-            if (!(entry.date() > prev.date()))
+            if (!(date > d_dates.back()))
                 throw Exception("Could not add entry to record; Date is earlier than latest entry currently in record.");
-            if (entry.metrics().size() != prev.metrics().size())
+            if (static_cast<int>(metrics.size()) != d_dim)
                 throw Exception("Could not add entry to record; Metric count is inconsistent with previous entries.");
         }
-        d_entries.push_back(std::move(entry));
+        else
+            d_dim = static_cast<int>(metrics.size());
+        insert_row(size(), EntryView{ date, notes, metrics });
+        touch();
     }
 
     void Record::remove(std::chrono::year_month_day date)
     {
        auto idx = find(date);
-        if (idx)
-           d_entries.erase(d_entries.begin() + *idx);
+        if (idx) {
+           auto const row = d_metrics.begin() + static_cast<std::ptrdiff_t>(*idx) * d_dim;
+           d_rollup.remove(date, std::span<double const>{ row, row + d_dim });
+           d_metrics.erase(row, row + d_dim);
+           d_dates.erase(d_dates.begin() + *idx);
+           auto const note = d_note_handles[*idx];
+           d_note_handles.erase(d_note_handles.begin() + *idx);
+           d_index.assign(d_dates);
+           d_prefix.truncate(*idx);
+           release(note);
+           touch();
+        }
+    }
+
+    void Record::remove(DateRange const& dates)
+    {
+        auto idxs = find(dates);
+        if (!idxs || *(idxs->max) < *(idxs->min))
+            return;
+        auto const first = *(idxs->min), last = *(idxs->max) + 1;
+        for (int i {first}; i < last; ++i)
+        {
+            auto const row = d_metrics.begin() + static_cast<std::ptrdiff_t>(i) * d_dim;
+            d_rollup.remove(d_dates[i], std::span<double const>{ row, row + d_dim });
+            d_notes.release(d_note_handles[i]);
+        }
+        d_metrics.erase(d_metrics.begin() + static_cast<std::ptrdiff_t>(first) * d_dim,
+                d_metrics.begin() + static_cast<std::ptrdiff_t>(last) * d_dim);
+        d_dates.erase(d_dates.begin() + first, d_dates.begin() + last);
+        d_note_handles.erase(d_note_handles.begin() + first, d_note_handles.begin() + last);
+        d_index.assign(d_dates);
+        d_prefix.truncate(first);
+        collect_notes();
+        touch();
+    }
+
+    void Record::remove(std::span<std::chrono::year_month_day const> dates)
+    {
+        std::vector<std::uint8_t> dead {};
+        int first { size() };
+        for (auto date: dates)
+        {
+            auto idx = find(date);
+            if (!idx)
+                continue;
+            if (dead.empty())
+                dead.resize(d_dates.size());
+            dead[*idx] = 1;
+            first = std::min(first, *idx);
+        }
+        if (!dead.empty())
+            compact(dead, first);
     }
 
     void Record::update(Entry const& entry)
     {
         auto date = entry.date();
+        if (!date.ok())
+            throw Exception("Could not update record; Date is not a valid calendar date.");
         auto idx = find(date);
+        auto const dim = static_cast<int>(entry.metrics().size());
+        // The metric count may only change if the entry would be the only one.
+        if (dim != d_dim && size() > (idx ? 1 : 0))
+            throw Exception("Could not update record; Metric count is inconsistent with previous entries.");
         if(idx) {
-            d_entries[*idx] = std::move(entry);
+            if (dim != d_dim) {
+                d_metrics.assign(entry.metrics().begin(), entry.metrics().end());
+                d_dim = dim;
+                d_rollup.clear();
+            } else {
+                auto const row = d_metrics.begin() + static_cast<std::ptrdiff_t>(*idx) * d_dim;
+                d_rollup.remove(date, std::span<double const>{ row, row + d_dim });
+                std::ranges::copy(entry.metrics(), row);
+            }
+            d_rollup.add(date, entry.metrics());
+            d_prefix.truncate(*idx);
+            auto const old = std::exchange(d_note_handles[*idx], d_notes.add(entry.notes()));
+            release(old);
         } else {  
-            // Add entry to the record
-            // We sort here instead of in add_entry to
-            // prevent frequent sorting operations.
-            d_entries.push_back(std::move(entry));
-            std::sort(d_entries.begin(), d_entries.end(), 
-                    [] (Entry const& a, Entry const& b) { return a < b; });
+            // Add entry to the record in date order.
+            d_dim = dim;
+            insert_row(d_index.lower_bound(date), entry);
+        }
+        touch();
+    }
+
+    void Record::merge(std::span<Entry const> entries, Conflict on_conflict)
+    {
+        if (entries.empty())
+            return;
+        auto const dim = static_cast<int>(entries[0].metrics().size());
+        if (!is_empty() && dim != d_dim)
+            throw Exception("Could not merge into record; Metric count is inconsistent with previous entries.");
+        for (auto const& e: entries)
+            if (!e.date().ok())
+                throw Exception("Could not merge into record; Date is not a valid calendar date.");
+        for (std::size_t j {1}; j < entries.size(); ++j)
+        {
+            if (!(entries[j].date() > entries[j - 1].date()))
+                throw Exception("Could not merge into record; Each entry must be a later date than the previous.");
+            if (static_cast<int>(entries[j].metrics().size()) != dim)
+                throw Exception("Could not merge into record; Entry found with different number of numeric responses.");
+        }
+
+        // Count the new dates (and vet conflicts) before anything is modified.
+        auto const old_size = size();
+        int added {0};
+        for (int i {0}; auto const& e: entries)
+        {
+            i = d_index.lower_bound(e.date(), i);
+            if (i < old_size && d_dates[i] == e.date()) {
+                if (on_conflict == Conflict::Throw)
+                    throw Exception("Could not merge into record; An entry already exists for a merged date.");
+            } else
+                ++added;
+        }
+        if (added == 0 && on_conflict == Conflict::KeepExisting)
+            return;
+        d_dim = dim;
+
+        // Merge from the back so that each row moves at most once and none is
+        // overwritten before it is moved.
+        auto const new_size = old_size + added;
+        auto const udim = static_cast<std::size_t>(d_dim);
+        d_dates.resize(static_cast<std::size_t>(new_size));
+        d_metrics.resize(static_cast<std::size_t>(new_size) * udim);
+        d_note_handles.resize(static_cast<std::size_t>(new_size));
+        auto row = [this, udim](int idx) -> std::span<double> {
+            return { d_metrics.data() + static_cast<std::size_t>(idx) * udim, udim };
+        };
+        auto move_row = [&](int from, int to) {
+            d_dates[to] = d_dates[from];
+            std::ranges::copy(row(from), row(to).begin());
+            d_note_handles[to] = d_note_handles[from];
+        };
+        auto put_entry = [&](Entry const& e, int to) {
+            d_dates[to] = e.date();
+            std::ranges::copy(e.metrics(), row(to).begin());
+            d_note_handles[to] = d_notes.add(e.notes());
+            d_rollup.add(e.date(), e.metrics());
+        };
+        int i { old_size - 1 }, k { new_size - 1 };
+        for (auto j = static_cast<int>(entries.size()) - 1; j >= 0; --k)
+        {
+            auto const& e = entries[static_cast<std::size_t>(j)];
+            if (i >= 0 && d_dates[i] > e.date())
+                move_row(i--, k);
+            else if (i >= 0 && d_dates[i] == e.date()) {
+                if (on_conflict == Conflict::Replace) {
+                    d_rollup.remove(d_dates[i], row(i));
+                    d_notes.release(d_note_handles[i]);
+                    put_entry(e, k);
+                } else
+                    move_row(i, k);
+                --i;
+                --j;
+            } else {
+                put_entry(e, k);
+                --j;
+            }
+        }
+        // Rows before `k + 1` were left in place.
+        d_prefix.truncate(k + 1);
+        if (k + 1 >= old_size)
+            for (int idx {old_size}; idx < new_size; ++idx)
+                d_index.push_back(d_dates[idx]);
+        else
+            d_index.assign(d_dates);
+        collect_notes();
+        touch();
+    }
+
+    void Record::compact(std::vector<std::uint8_t> const& dead, int first)
+    {
+        auto const udim = static_cast<std::size_t>(d_dim);
+        std::size_t kept { static_cast<std::size_t>(first) };
+        for (auto i = kept; i < d_dates.size(); ++i)
+        {
+            auto const row = d_metrics.begin() + static_cast<std::ptrdiff_t>(i * udim);
+            if (dead[i]) {
+                d_rollup.remove(d_dates[i], std::span<double const>{ row, udim });
+                d_notes.release(d_note_handles[i]);
+                continue;
+            }
+            if (kept != i) {
+                d_dates[kept] = d_dates[i];
+                d_note_handles[kept] = d_note_handles[i];
+                std::copy(row, row + static_cast<std::ptrdiff_t>(udim),
+                        d_metrics.begin() + static_cast<std::ptrdiff_t>(kept * udim));
+            }
+            ++kept;
         }
+        d_dates.resize(kept);
+        d_note_handles.resize(kept);
+        d_metrics.resize(kept * udim);
+        d_index.assign(d_dates);
+        d_prefix.truncate(first);
+        collect_notes();
+        touch();
+    }
+
+    void Record::insert_row(int idx, EntryView entry)
+    {
+        d_dates.insert(d_dates.begin() + idx, entry.date());
+        d_metrics.insert(d_metrics.begin() + static_cast<std::ptrdiff_t>(idx) * d_dim,
+                entry.metrics().begin(), entry.metrics().end());
+        d_note_handles.insert(d_note_handles.begin() + idx, d_notes.add(entry.notes()));
+        d_prefix.truncate(idx);
+        d_rollup.add(entry.date(), entry.metrics());
+        // Appending leaves every other row in place.
+        if (idx == size() - 1)
+            d_index.push_back(entry.date());
+        else
+            d_index.assign(d_dates);
+    }
+
+    void Record::collect_notes()
+    {
+        if (!d_notes.should_compact())
+            return;
+        NoteHeap compacted { d_notes.resource() };
+        compacted.reserve(d_notes.size() - d_notes.garbage());
+        for (auto& handle: d_note_handles)
+            handle = compacted.add(d_notes.get(handle));
+        d_notes = std::move(compacted);
+    }
+
+    void Record::release(NoteHandle note)
+    {
+        d_notes.release(note);
+        collect_notes();
+    }
+
+    void Record::touch() noexcept
+    {
+        d_version = g_last_version.fetch_add(1, std::memory_order_relaxed) + 1;
     }
 
     auto operator<<(std::ostream& os, Record const& rec) noexcept -> std::ostream&
     {
         os << "[\n";
-        for (Entry const& e: rec)
+        for (EntryView e: rec)
             os  << e << ",\n";
         os << "]";
         return os;
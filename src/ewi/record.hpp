@@ -27,10 +27,45 @@
 #define INCLUDED_STD_CHRONO
 #endif
 
-// std::reference_wrapper
-#ifndef INCLUDED_STD_FUNCTIONAL
-#include <functional>
-#define INCLUDED_STD_FUNCTIONAL
+#ifndef INCLUDED_EWI_CALENDAR_ROLLUP
+#include "calendar_rollup.hpp"
+#endif
+
+#ifndef INCLUDED_EWI_DAY_INDEX
+#include "day_index.hpp"
+#endif
+
+#ifndef INCLUDED_EWI_METRIC_PREFIX
+#include "metric_prefix.hpp"
+#endif
+
+#ifndef INCLUDED_EWI_NOTE_HEAP
+#include "note_heap.hpp"
+#endif
+
+#ifndef INCLUDED_STD_COMPARE
+#include <compare>
+#define INCLUDED_STD_COMPARE
+#endif
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_CSTDINT
+#include <cstdint>
+#define INCLUDED_STD_CSTDINT
+#endif
+
+#ifndef INCLUDED_STD_ITERATOR
+#include <iterator>
+#define INCLUDED_STD_ITERATOR
+#endif
+
+#ifndef INCLUDED_STD_MEMORY_RESOURCE
+#include <memory_resource>
+#define INCLUDED_STD_MEMORY_RESOURCE
 #endif
 
 #ifndef INCLUDED_STD_OPTIONAL
@@ -38,11 +73,31 @@
 #define INCLUDED_STD_OPTIONAL
 #endif
 
+#ifndef INCLUDED_STD_RANGES
+#include <ranges>
+#define INCLUDED_STD_RANGES
+#endif
+
 #ifndef INCLUDED_STD_OSTREAM
 #include <ostream>
 #define INCLUDED_STD_OSTREAM
 #endif
 
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
+#ifndef INCLUDED_STD_STRING
+#include <string>
+#define INCLUDED_STD_STRING
+#endif
+
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
 #ifndef INCLUDED_STD_VECTOR
 #include <vector>
 #define INCLUDED_STD_VECTOR
@@ -85,78 +140,296 @@ namespace ewi
     // std::ostream& operator<< (std::ostream& os, DateRange const&);
     std::ostream& operator<< (std::ostream& os, IndexRange const&);
 
+    /// A read-only view of the metrics of consecutive entries, stored row-major (one row
+    /// per Entry) in a single contiguous block. Like an `EntryView`, it is invalidated by
+    /// any modification of the Record it refers to.
+    class MetricRows
+    {
+        public:
+            MetricRows() = default;
+            MetricRows(double const* data, int rows, int cols) noexcept
+                : d_data{data}, d_rows{rows}, d_cols{cols} {}
+
+            inline auto rows() const noexcept -> int { return d_rows; }
+            inline auto cols() const noexcept -> int { return d_cols; }
+            /// Query number of rows (entries) in the view.
+            inline auto size() const noexcept -> int { return d_rows; }
+            /// All viewed metrics, row after row.
+            inline auto data() const noexcept -> std::span<double const>
+            {
+                return { d_data, static_cast<std::size_t>(d_rows) * static_cast<std::size_t>(d_cols) };
+            }
+            /// The metrics of the `row`th viewed entry. No bounds checking is performed.
+            inline auto operator[] (int row) const noexcept -> std::span<double const>
+            {
+                return { d_data + static_cast<std::ptrdiff_t>(row) * d_cols, static_cast<std::size_t>(d_cols) };
+            }
+        private:
+            double const* d_data {};
+            int d_rows {};
+            int d_cols {};
+    };
     
+    class EntryRange;
+
+    /// Per-range entry counts and metric means (see `Record::aggregate`), in the order the
+    /// ranges were given.
+    struct RangeMeans
+    {
+        std::vector<int> counts {};
+        std::vector<double> means {};  // row-major; size() x dim. NaN for empty ranges.
+        int dim {};
+
+        inline auto size() const noexcept -> int { return static_cast<int>(counts.size()); }
+        /// The metric means of the `i`th range. No bounds checking is performed.
+        inline auto mean(int i) const noexcept -> std::span<double const>
+        {
+            return { means.data() + static_cast<std::ptrdiff_t>(i) * dim, static_cast<std::size_t>(dim) };
+        }
+    };
+
+    /// Per-metric statistics of the entries within a date range (see `Record::summarize`).
+    struct MetricSummary
+    {
+        int count {};  // number of entries summarized
+        std::vector<double> mean {};
+        std::vector<double> variance {};  // population variance
+    };
+
+    /// The columns of a Record as gathered by a parser: `dates.size()` rows of `dim`
+    /// metrics each (row-major) and the rows' notes back to back, row `i`'s spanning
+    /// `[note_offsets[i], note_offsets[i + 1])` of `notes`.
+    struct RecordColumns
+    {
+        std::pmr::vector<std::chrono::year_month_day> dates {};
+        std::pmr::vector<double> metrics {};
+        int dim {};
+        std::pmr::string notes {};
+        std::vector<std::uint32_t> note_offsets { 0 };
+    };
+
     /// A collection of entries
+    ///
+    /// Entries are not stored as `Entry` objects but column by column: a date column, a
+    /// single row-major `size() x metric_dim()` metric buffer, and a column of handles to
+    /// notes, which live out-of-line in a `NoteHeap` since EWI calculations never read
+    /// them. A date range's metrics are thus one contiguous block, and entries cost no
+    /// allocations of their own. Accessors return views (`EntryView`, `EntryRange`,
+    /// `MetricRows`), which are invalidated by any modification of the Record.
+    ///
+    /// Each Record carries a version that changes whenever its entries do. Versions are
+    /// drawn from a process-wide counter, so two Records share a version only if one is a
+    /// copy of the other made since its last change (or both are default-constructed).
+    /// Comparing a saved version with the current one therefore tells whether a Record
+    /// was modified, even if it was replaced wholesale.
+    ///
+    /// Every date must be `ok()`: the date index counts days, so a date such as February
+    /// 30th would be found under another day. Constructors and manipulators throw an
+    /// exception, leaving the Record unchanged, when given such a date.
+    ///
+    /// The columns, note heap, indices, and cached sums are allocated from a
+    /// `std::pmr::memory_resource` chosen at construction (the default resource unless one
+    /// is given), which must outlive the Record. Copies are allocated from the default
+    /// resource unless one is passed (see `allocator_type`); assignment keeps the target's
+    /// resource.
     class Record 
     {
         public:
             enum class Err { InconsistentMetrics, DisorderedDate, };
+            /// How `merge` treats an incoming entry dated like one already in the Record.
+            enum class Conflict { KeepExisting, Replace, Throw, };
+            using allocator_type = std::pmr::polymorphic_allocator<>;
             // CONSTRUCTORS
             Record() = default;
-            Record(std::vector<Entry>& entries);
+            /// Creates an empty Record allocated from `resource`.
+            explicit Record(std::pmr::memory_resource* resource);
+            /// Copies (or moves) a Record into one allocated from `alloc`. Moving takes the
+            /// other Record's buffers over only if they come from the same resource.
+            Record(Record const& other, allocator_type alloc);
+            Record(Record&& other, allocator_type alloc);
+            Record(std::vector<Entry>& entries, std::pmr::memory_resource* resource=std::pmr::get_default_resource());
+            /// Builds a Record straight from its columns (ex. as parsed from a file), with
+            /// no `Entry` formed along the way. Buffers allocated from `resource` are taken
+            /// over rather than copied. Throws an exception if the dates are not valid and
+            /// strictly increasing or the columns' sizes disagree.
+            explicit Record(RecordColumns&& columns, std::pmr::memory_resource* resource=std::pmr::get_default_resource());
+
+            /// Random-access iterator over the Record's entries. Dereferencing yields an
+            /// `EntryView` by value.
+            class Iterator
+            {
+                public:
+                    using iterator_concept = std::random_access_iterator_tag;
+                    using iterator_category = std::input_iterator_tag;
+                    using value_type = EntryView;
+                    using reference = EntryView;
+                    using difference_type = std::ptrdiff_t;
+
+                    Iterator() = default;
+                    Iterator(Record const* rec, difference_type idx) noexcept : d_rec{rec}, d_idx{idx} {}
+
+                    inline auto operator*() const -> EntryView { return (*d_rec)[static_cast<int>(d_idx)]; }
+                    inline auto operator[](difference_type n) const -> EntryView { return *(*this + n); }
+                    inline auto operator++() noexcept -> Iterator& { ++d_idx; return *this; }
+                    inline auto operator++(int) noexcept -> Iterator { auto tmp = *this; ++d_idx; return tmp; }
+                    inline auto operator--() noexcept -> Iterator& { --d_idx; return *this; }
+                    inline auto operator--(int) noexcept -> Iterator { auto tmp = *this; --d_idx; return tmp; }
+                    inline auto operator+=(difference_type n) noexcept -> Iterator& { d_idx += n; return *this; }
+                    inline auto operator-=(difference_type n) noexcept -> Iterator& { d_idx -= n; return *this; }
+                    inline friend auto operator+(Iterator it, difference_type n) noexcept -> Iterator { return it += n; }
+                    inline friend auto operator+(difference_type n, Iterator it) noexcept -> Iterator { return it += n; }
+                    inline friend auto operator-(Iterator it, difference_type n) noexcept -> Iterator { return it -= n; }
+                    inline friend auto operator-(Iterator const& a, Iterator const& b) noexcept -> difference_type { return a.d_idx - b.d_idx; }
+                    inline friend auto operator==(Iterator const& a, Iterator const& b) noexcept -> bool { return a.d_idx == b.d_idx; }
+                    inline friend auto operator<=>(Iterator const& a, Iterator const& b) noexcept -> std::strong_ordering { return a.d_idx <=> b.d_idx; }
+                private:
+                    Record const* d_rec {};
+                    difference_type d_idx {};
+            };
 
             // ACCESSORS
 
+            /// Computes the entry count and metric means of each date range in one pass.
+            ///
+            /// Only batches whose minima, and separately whose maxima, are already in date
+            /// order (ex. a weekly time series) are located by a single forward sweep over
+            /// the dates, galloping from each bound to the next (see `DayIndex`). Other
+            /// batches are not sorted first, since sorting costs more than the searches
+            /// it would save; each of their bounds is found by its own binary search. The
+            /// means come from the same cumulative sums as `summarize`, so the ranges share
+            /// one up-to-date copy of them.
+            auto aggregate(std::span<DateRange const> ranges) const -> RangeMeans;
             /// Iterators
-            /// TODO: Read about std::ranges to understand how it works and what type I
-            /// should return. Currently, I'm deriving the type via `auto` (and
-            /// inlining the function) because I don't
-            /// know how to define the signature myself.
-            inline auto begin() const noexcept { return d_entries.begin(); }
-            inline auto end() const noexcept { return d_entries.end(); }
-
-            /// Gets the direct index for a single entry, if it exists.
+            inline auto begin() const noexcept -> Iterator { return Iterator{ this, 0 }; }
+            inline auto end() const noexcept -> Iterator { return Iterator{ this, static_cast<std::ptrdiff_t>(d_dates.size()) }; }
+
+            /// Gets the direct index for a single entry, if it exists. Takes constant time
+            /// (see `DayIndex`).
             auto find(std::chrono::year_month_day date) const noexcept -> std::optional<int>;
             /// Get the index range of entries within a given date range. Returns
             /// singularity IndexRange (ex. {0, 0}) if a singularity DateRange is passed in
             /// and an Entry exists for that date.
             auto find(DateRange range) const noexcept -> std::optional<IndexRange>;
 
-            /// Retrieves a reference to the entry with the given date(s) if it exists.
-            auto get(std::chrono::year_month_day date) const noexcept -> std::optional<std::reference_wrapper<Entry const>>;
-            auto get(DateRange const& dates) const noexcept -> std::optional<std::vector<std::reference_wrapper<Entry const>>>;
+            /// Retrieves a view of the entry with the given date(s) if it exists. Neither
+            /// overload allocates. A range containing no entries may yield an empty view.
+            auto get(std::chrono::year_month_day date) const noexcept -> std::optional<EntryView>;
+            auto get(DateRange const& dates) const noexcept -> std::optional<EntryRange>;
 
             /// Query if Record has no entries.
             auto is_empty() const noexcept -> bool; 
             /// Query how many metrics are recorded per entry.
             auto metric_dim() const noexcept -> int;
-            /// Retrieve metrics for a given date range.
-            ///
-            /// NOTE:
-            ///     The const on the metrics is cast away to be compatible with Eigen.  The
-            ///     assumption is that this method will never be used to modify metrics
-            ///     directly.
+            /// Retrieve metrics for a given date (range). No data is copied.
+            auto metrics(std::chrono::year_month_day date) const noexcept -> std::optional<std::span<double const>>;
+            auto metrics(DateRange const& dates) const noexcept -> std::optional<MetricRows>;
+            /// Computes the mean and variance of each metric over a date range. Returns
+            /// `std::nullopt` if no entries fall within it.
             ///
-            ///     The alternative was to define multiple const/non-const variations of
-            ///     each method, even extending to changes in ewi::Entry. That may be
-            ///     viable in the future, but for now, I'll stick to this simple solution.
-            auto metrics(std::chrono::year_month_day date) const noexcept -> std::optional<std::reference_wrapper<std::vector<double>>>;
-            auto metrics(DateRange const& dates) const noexcept -> std::optional<std::vector<std::reference_wrapper<std::vector<double>>>>;
+            /// Backed by cumulative sums (see `MetricPrefixSums`), so each call costs two
+            /// binary searches and one subtraction per metric. The sums are built by the
+            /// first call and extended by later ones as entries are added; changing or
+            /// removing an entry discards the sums from that entry on. Since the sums are
+            /// updated by this (const) function, concurrent calls on the same Record must
+            /// be synchronized.
+            auto summarize(DateRange const& dates) const -> std::optional<MetricSummary>;
 
+            /// Gets the metric means of each calendar period (ex. month) overlapping the
+            /// date range, earliest first. Periods are summarized in full, and those
+            /// without entries are omitted. Takes time proportional to the number of
+            /// periods returned, no matter how many entries they hold (see
+            /// `CalendarRollup`).
+            auto rollup(CalendarPeriod period, DateRange const& dates={}) const -> PeriodSummaries;
+            /// Query the allocator the Record's entries are allocated from.
+            inline auto get_allocator() const noexcept -> allocator_type { return d_dates.get_allocator(); }
+            /// Query the memory resource the Record's entries are allocated from.
+            inline auto resource() const noexcept -> std::pmr::memory_resource*
+            {
+                return d_dates.get_allocator().resource();
+            }
             /// Query number of entries in the record.
             auto size() const noexcept -> int;
+            /// Query the Record's version (see class documentation).
+            inline auto version() const noexcept -> std::uint64_t { return d_version; }
             /// Access the Record via numeric index. 
             ///
             /// Note: This method does not perform bounds checking. It's recommended to use
             /// this method of access only after receiving valid indices from a call to
             /// `Record::find()`;
-            auto operator[] (int idx) const -> Entry const&; 
-            auto operator<=> (Record const& rhs) const = default;
+            auto operator[] (int idx) const -> EntryView;
+            /// Records compare by their entries; versions are not part of the value.
+            auto operator== (Record const& rhs) const -> bool;
+            auto operator<=> (Record const& rhs) const -> std::strong_ordering;
 
             // MANIPULATORS
 
             /// Inserts an entry to the record.
             void add(Entry const& entry);
+            /// Inserts an entry made of the given data. Like `add`, but the data is copied
+            /// straight into the Record's columns, so no `Entry` need be built first.
+            void emplace(std::chrono::year_month_day date, std::string_view notes, std::span<double const> metrics);
+            /// Merges a batch of entries, sorted by strictly increasing date, into the
+            /// record in one pass over both (linear time, unlike repeated `update` calls).
+            /// Entries dated like an existing one are handled according to `on_conflict`.
+            /// Throws an exception, leaving the record unchanged, if the batch is out of
+            /// order or holds an invalid date, its metric count differs from the record's, or a conflict arises
+            /// under `Conflict::Throw`.
+            void merge(std::span<Entry const> entries, Conflict on_conflict=Conflict::Replace);
             /// Removes entry with specified date.
             /// If no such entry exists, do nothing.
             void remove(std::chrono::year_month_day date);
+            /// Removes every entry within the date range (ex. `DateRange{ .max=cutoff }` to
+            /// apply a retention policy). Takes linear time however many entries go.
+            void remove(DateRange const& dates);
+            /// Removes the entries with the given dates, in any order; dates without an
+            /// entry are ignored. The entries are first marked as deleted and the columns
+            /// are then compacted in a single pass, so removing many entries takes linear
+            /// time rather than one shift of the later entries per removal.
+            void remove(std::span<std::chrono::year_month_day const> dates);
             /// Replace exisiting entry with a new one.
-            /// If no such entry exists, it's added.
+            /// If no such entry exists, it's added in date order.
             void update(Entry const& entry);
         private:
-            std::vector<Entry> d_entries {};
+            /// Inserts the entry's data as row `idx` of each column.
+            void insert_row(int idx, EntryView entry);
+            /// Rebuilds the note heap if it is mostly garbage.
+            void collect_notes();
+            /// Drops the rows flagged in `dead` (one flag per row), none of which precede
+            /// row `first`, shifting each remaining row once.
+            void compact(std::vector<std::uint8_t> const& dead, int first);
+            /// Releases a note, rebuilding the note heap once it is mostly garbage.
+            void release(NoteHandle note);
+            /// Marks the Record as modified.
+            void touch() noexcept;
+
+            std::pmr::vector<std::chrono::year_month_day> d_dates {};
+            std::pmr::vector<double> d_metrics {};  // row-major; size() x d_dim
+            std::pmr::vector<NoteHandle> d_note_handles {};
+            NoteHeap d_notes {};
+            DayIndex d_index {};  // date -> row; rebuilt when rows shift
+            CalendarRollup d_rollup {};  // per-period counts and sums
+            mutable MetricPrefixSums d_prefix {};  // cache; extended on demand
+            int d_dim {};
+            std::uint64_t d_version {};
     };
     auto operator<<(std::ostream& os, Record const& rec) noexcept -> std::ostream&;
 
+    /// A view of consecutive entries of a Record (see `Record::get`). Creating one
+    /// allocates nothing. Like an `EntryView`, it is invalidated by any modification of the
+    /// Record.
+    class EntryRange : public std::ranges::view_interface<EntryRange>
+    {
+        public:
+            EntryRange() = default;
+            EntryRange(Record::Iterator first, Record::Iterator last) noexcept
+                : d_begin{first}, d_end{last} {}
+
+            inline auto begin() const noexcept -> Record::Iterator { return d_begin; }
+            inline auto end() const noexcept -> Record::Iterator { return d_end; }
+        private:
+            Record::Iterator d_begin {};
+            Record::Iterator d_end {};
+    };
+
 } // namespace ewi
 #endif // INCLUDED_EWI_RECORD
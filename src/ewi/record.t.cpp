@@ -18,9 +18,15 @@
 */
 #include "record.hpp"
 //- STL
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 //#include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
 #include <vector>
 //- In-house
 #include "entry.hpp"
@@ -29,12 +35,32 @@
 void test_find_entries();
 void test_record_ops();
 void test_metric_retrieval();
+void test_versioning();
+void test_notes_storage();
+void test_date_lookup();
+void test_range_search();
+void test_summaries();
+void test_rollups();
+void test_aggregate();
+void test_merge();
+void test_bulk_removal();
+void test_invalid_dates();
 
 int main()
 {
     test_find_entries();
     test_record_ops();
     test_metric_retrieval();
+    test_versioning();
+    test_notes_storage();
+    test_date_lookup();
+    test_range_search();
+    test_summaries();
+    test_rollups();
+    test_aggregate();
+    test_merge();
+    test_bulk_removal();
+    test_invalid_dates();
 }
 
 //-----------------------------------------Implementation--------------------------------------
@@ -148,7 +174,7 @@ void test_record_ops()
     Entry insertion1 (dates[3], "Inserted from `add`", std::vector<double>{2.0});
 
     rec.update(replacement);
-    assert(rec.get(dates[1])->get().notes() == "Replacement Entry");
+    assert(rec.get(dates[1])->notes() == "Replacement Entry");
     //std::cout << "\nFirst Replacement\n" << rec << "\n";
     rec.update(insertion0);
     assert(rec.size() == ORIG_SIZE + 1);
@@ -168,6 +194,488 @@ void test_metric_retrieval()
     auto metrics = rec.metrics({ std::nullopt, 2024y/std::chrono::December/31d });
     assert(metrics);
     assert(metrics->size() == NUM_ENTRIES);
-    for (auto const& vec : *metrics)
-       assert (vec.get() == METRICS); 
+    assert(metrics->cols() == static_cast<int>(METRICS.size()));
+    for (int i {0}; i < metrics->size(); ++i)
+       assert (std::ranges::equal((*metrics)[i], METRICS)); 
+    // Rows are contiguous.
+    assert(metrics->data().size() == NUM_ENTRIES * METRICS.size());
+    assert((*metrics)[1].data() == metrics->data().data() + METRICS.size());
+    assert(std::ranges::equal(*rec.metrics(dates[0]), METRICS));
+
+    // Entry ranges view the Record in place.
+    auto entries = rec.get(DateRange{ .max=2024y/std::chrono::December/31d });
+    assert(entries && entries->size() == NUM_ENTRIES);
+    assert(std::ranges::equal(*entries, ewi::EntryRange(rec.begin(), rec.begin() + NUM_ENTRIES)));
+    assert((*entries)[1] == rec[1]);
+    // Reversed bounds view nothing rather than a negative count.
+    DateRange const reversed { dates[1], dates[0] };
+    assert(rec.get(reversed) && rec.get(reversed)->empty());
+    assert(rec.metrics(reversed) && rec.metrics(reversed)->size() == 0);
+}
+
+/// Versions change with every modification and are not part of a Record's value.
+void test_versioning()
+{
+    Record empty {};
+    assert(empty.version() == 0);
+
+    auto rec = gen_record(2);
+    auto const built = rec.version();
+    assert(built != 0);
+    Record copy { rec };
+    assert(copy.version() == built && copy == rec);
+
+    rec.add(entry_from(dates[2]));
+    auto const added = rec.version();
+    assert(added != built);
+    rec.update(entry_from(dates[2]));
+    assert(rec.version() != added);
+    auto const updated = rec.version();
+    rec.remove(2000y/std::chrono::January/1d);  // no such entry
+    assert(rec.version() == updated);
+    rec.remove(dates[2]);
+    assert(rec.version() != updated);
+
+    // Same contents, different history.
+    assert(rec == copy && rec.version() != copy.version());
+    // Independently built Records never share a version.
+    assert(gen_record(2).version() != gen_record(2).version());
+}
+
+/// Notes survive replacement and removal of their neighbours, including once the Record
+/// reclaims the space of discarded notes.
+void test_notes_storage()
+{
+    using namespace std::chrono;
+    std::string const long_note (1000, 'n');
+    std::vector<Entry> entries {};
+    sys_days day { 2024y / January / 1d };
+    for (int i {0}; i < 20; ++i, day += days{1})
+        entries.emplace_back(Date{ day }, std::to_string(i) + long_note, std::vector<double>{ double(i) });
+    Record rec { entries };
+
+    for (int i {0}; i < 20; i += 2)
+        rec.update(Entry(rec[i].date(), "short", rec[i].to_entry().metrics()));
+    for (int i {0}; i < 5; ++i)
+        rec.remove(rec[rec.size() - 1].date());
+
+    assert(rec.size() == 15);
+    for (int i {0}; i < rec.size(); ++i) {
+        auto const e = rec[i];
+        assert(e.notes() == ((i % 2 == 0) ? std::string("short") : std::to_string(i) + long_note));
+        assert(e.metrics()[0] == double(i));
+    }
+    Entry const empty_notes (Date{ day }, "", std::vector<double>{ 0. });
+    rec.add(empty_notes);
+    assert(*rec.get(empty_notes.date()) == empty_notes);
+}
+
+/// Single-date lookups must agree with a linear scan after every kind of modification.
+void test_date_lookup()
+{
+    using namespace std::chrono;
+    auto check = [](Record const& rec) {
+        for (int i {0}; i < rec.size(); ++i)
+            assert(rec.find(rec[i].date()) == i);
+        for (sys_days day { 2023y / December / 1d }; day < sys_days{ 2024y / April / 1d }; day += days{1})
+        {
+            Date const date { day };
+            bool const present = std::ranges::any_of(rec, [&](auto const& e) { return e.date() == date; });
+            assert(rec.find(date).has_value() == present);
+        }
+    };
+    Record rec {};
+    check(rec);
+    for (sys_days day { 2024y / January / 1d }; day < sys_days{ 2024y / March / 1d }; day += days{2})
+        rec.add(Entry(Date{ day }, "", std::vector<double>{ 1. }));
+    check(rec);
+    rec.update(Entry(2024y / January / 2d, "Back-dated", std::vector<double>{ 2. }));
+    rec.update(Entry(2023y / December / 25d, "Before the first", std::vector<double>{ 2. }));
+    check(rec);
+    rec.remove(2024y / January / 1d);
+    rec.remove(2024y / February / 29d);
+    check(rec);
+    // A gap far larger than the record switches to the sparse index.
+    rec.add(Entry(2030y / January / 1d, "", std::vector<double>{ 3. }));
+    check(rec);
+    assert(rec.find(2030y / January / 1d) == rec.size() - 1);
+}
+
+namespace
+{
+    /// Linear-scan reference for `Record::find(DateRange)` over a sorted column of unique
+    /// dates: the first date not before the minimum through the last date not after the
+    /// maximum.
+    auto scan_find(std::vector<Date> const& dates, DateRange range) -> std::optional<IndexRange>
+    {
+        int const n { static_cast<int>(dates.size()) };
+        int first {0}, last { n - 1 };
+        if (range.min)
+            while (first < n && dates[first] < *range.min)
+                ++first;
+        if (range.max)
+            while (last >= 0 && dates[last] > *range.max)
+                --last;
+        bool const singular { range.min && range.max && *range.min == *range.max };
+        if (first == n || last < 0 || (singular && first > last))
+            return std::nullopt;
+        return IndexRange{ first, last };
+    }
+}
+
+/// Range searches must match a linear scan on random Records and random (including
+/// reversed, unbounded, and not-`ok()`) ranges.
+void test_range_search()
+{
+    using namespace std::chrono;
+    std::mt19937 gen { 2024 };
+    for (int count: { 0, 1, 2, 3, 4, 5, 8, 17, 100, 1000 })
+        for (int max_gap: { 1, 3, 40 })
+        {
+            std::uniform_int_distribution<int> gap { 1, max_gap };
+            Record rec {};
+            std::vector<Date> dates {};
+            sys_days day { 2020y / January / 1d };
+            for (int i {0}; i < count; ++i, day += days{ gap(gen) }) {
+                rec.add(Entry(Date{ day }, "", std::vector<double>{ 1. }));
+                dates.push_back(Date{ day });
+            }
+
+            auto const first = sys_days{ 2020y / January / 1d } - days{ 10 };
+            std::uniform_int_distribution<int> offset { 0, static_cast<int>((day - first).count()) + 10 };
+            std::uniform_int_distribution<int> kind { 0, 9 };
+            auto random_bound = [&]() -> std::optional<Date> {
+                switch (kind(gen)) {
+                    case 0: return std::nullopt;
+                    case 1: return Date{ 2020y, February, 30d };  // not ok(), sorts by fields
+                    case 2: return dates.empty() ? Date{ first } : dates[offset(gen) % dates.size()];
+                    default: return Date{ first + days{ offset(gen) } };
+                }
+            };
+            for (int q {0}; q < 500; ++q) {
+                DateRange const range { random_bound(), random_bound() };
+                assert(rec.find(range) == scan_find(dates, range));
+            }
+        }
+}
+
+/// Range summaries must track the Record through appends, updates, and removals.
+void test_summaries()
+{
+    using namespace std::chrono;
+    auto check = [](Record const& rec, DateRange const& range) {
+        auto summary = rec.summarize(range);
+        auto rows = rec.metrics(range);
+        if (!rows || rows->size() == 0) {
+            assert(!summary);
+            return;
+        }
+        assert(summary && summary->count == rows->size());
+        for (int col {0}; col < rows->cols(); ++col) {
+            double mean {}, variance {};
+            for (int row {0}; row < rows->size(); ++row)
+                mean += (*rows)[row][col];
+            mean /= rows->size();
+            for (int row {0}; row < rows->size(); ++row)
+                variance += ((*rows)[row][col] - mean) * ((*rows)[row][col] - mean);
+            variance /= rows->size();
+            assert(std::abs(summary->mean[col] - mean) < 1e-9);
+            assert(std::abs(summary->variance[col] - variance) < 1e-9);
+        }
+    };
+    std::vector<DateRange> const ranges {
+        DateRange{}, DateRange{ .max=2024y/February/1d }, DateRange{ .min=2024y/January/10d },
+        DateRange{ 2024y/January/5d, 2024y/January/20d }, DateRange{ 2024y/January/7d, 2024y/January/7d },
+        DateRange{ 2024y/March/1d, 2024y/April/1d }, DateRange{ 2024y/January/20d, 2024y/January/5d },
+    };
+    auto check_all = [&](Record const& rec) {
+        for (auto const& range: ranges)
+            check(rec, range);
+    };
+
+    Record rec {};
+    check_all(rec);
+    sys_days day { 2024y / January / 1d };
+    for (int i {0}; i < 30; ++i, day += days{1}) {
+        rec.add(Entry(Date{ day }, "", std::vector<double>{ double(i % 7), 2.5, double(i * i) }));
+        if (i % 10 == 0)
+            check_all(rec);
+    }
+    check_all(rec);
+    rec.update(Entry(2024y / January / 7d, "", std::vector<double>{ 100., -1., 0. }));
+    check_all(rec);
+    rec.update(Entry(2023y / December / 1d, "", std::vector<double>{ 3., 3., 3. }));
+    check_all(rec);
+    rec.remove(2024y / January / 15d);
+    check_all(rec);
+    Record const copy { rec };
+    check_all(copy);
+}
+
+/// Each calendar period's rollup must agree with summarizing the period's date range.
+void test_rollups()
+{
+    using namespace std::chrono;
+    using ewi::CalendarPeriod;
+    auto check = [](Record const& rec) {
+        for (auto period: { CalendarPeriod::Week, CalendarPeriod::Month, CalendarPeriod::Quarter, CalendarPeriod::Year })
+        {
+            auto const periods = rec.rollup(period);
+            int total {0};
+            for (int i {0}; i < periods.size(); ++i) {
+                sys_days const start { periods.starts[i] };
+                auto end = start;  // last day of the period
+                while (ewi::CalendarRollup::period_start(period, Date{ end + days{1} }) == start)
+                    end += days{1};
+                auto summary = rec.summarize(DateRange{ Date{ start }, Date{ end } });
+                assert(summary && summary->count == periods.counts[i]);
+                for (int col {0}; col < rec.metric_dim(); ++col)
+                    assert(std::abs(summary->mean[col] - periods.mean(i)[col]) < 1e-9);
+                total += periods.counts[i];
+            }
+            assert(total == rec.size());
+        }
+    };
+    Record rec {};
+    check(rec);
+    sys_days day { 2023y / November / 20d };
+    for (int i {0}; i < 200; ++i, day += days{ 1 + i % 3 })
+        rec.add(Entry(Date{ day }, "", std::vector<double>{ double(i % 7), double(i / 10) }));
+    check(rec);
+    rec.update(Entry(rec[50].date(), "", std::vector<double>{ 40., -3. }));
+    rec.update(Entry(2023y / January / 1d, "", std::vector<double>{ 1., 1. }));
+    rec.remove(rec[100].date());
+    check(rec);
+    auto const months = rec.rollup(CalendarPeriod::Month, DateRange{ 2024y / March / 15d, 2024y / May / 1d });
+    assert(months.size() == 3 && months.starts[0] == 2024y / March / 1d && months.starts[2] == 2024y / May / 1d);
+    // A Record whose only entry changes its metric count starts its rollups over.
+    Record single {};
+    single.add(Entry(2024y / January / 1d, "", std::vector<double>{ 1. }));
+    single.update(Entry(2024y / January / 1d, "", std::vector<double>{ 2., 4. }));
+    auto const year = single.rollup(CalendarPeriod::Year);
+    assert(year.size() == 1 && year.dim == 2 && year.mean(0)[1] == 4.);
+}
+
+/// Batched range queries must match answering each range on its own, whatever order the
+/// ranges come in.
+void test_aggregate()
+{
+    using namespace std::chrono;
+    std::mt19937 gen { 20 };
+    Record rec {};
+    assert(rec.aggregate(std::vector<DateRange>{ DateRange{} }).counts == std::vector<int>{ 0 });
+
+    std::vector<Date> dates {};
+    sys_days day { 2022y / January / 1d };
+    for (int i {0}; i < 500; ++i, day += days{ 1 + i % 4 }) {
+        rec.add(Entry(Date{ day }, "", std::vector<double>{ double(i % 11), double(i) }));
+        dates.push_back(Date{ day });
+    }
+    std::uniform_int_distribution<int> offset { -20, static_cast<int>((day - sys_days{ 2022y / January / 1d }).count()) + 20 };
+    std::uniform_int_distribution<int> kind { 0, 9 };
+    auto random_bound = [&]() -> std::optional<Date> {
+        if (kind(gen) == 0)
+            return std::nullopt;
+        return Date{ sys_days{ 2022y / January / 1d } + days{ offset(gen) } };
+    };
+    std::vector<DateRange> ranges {};
+    for (int i {0}; i < 1000; ++i)
+        ranges.push_back(DateRange{ random_bound(), random_bound() });
+    // Consecutive weeks, already in order.
+    for (sys_days week { 2022y / January / 3d }; week < day; week += days{7})
+        ranges.push_back(DateRange{ Date{ week }, Date{ week + days{6} } });
+
+    auto const batch = rec.aggregate(ranges);
+    assert(batch.size() == static_cast<int>(ranges.size()) && batch.dim == 2);
+    for (int i {0}; i < batch.size(); ++i) {
+        auto const expected = scan_find(dates, ranges[i]);
+        int const count = expected ? std::max(0, *expected->max - *expected->min + 1) : 0;
+        assert(batch.counts[i] == count);
+        if (count == 0) {
+            assert(std::isnan(batch.mean(i)[0]));
+            continue;
+        }
+        auto const summary = rec.summarize(ranges[i]);
+        for (int col {0}; col < 2; ++col)
+            assert(std::abs(batch.mean(i)[col] - summary->mean[col]) < 1e-9);
+    }
+}
+
+/// Merging a batch must match inserting its entries one at a time with `update`.
+void test_merge()
+{
+    using namespace std::chrono;
+    auto make = [](sys_days d, double x, std::string note) -> Entry {
+        return Entry(Date{ d }, std::move(note), std::vector<double>{ x, 2. * x });
+    };
+    Record rec {};
+    sys_days const start { 2024y / January / 1d };
+    for (int i {0}; i < 60; i += 2)
+        rec.add(make(start + days{i}, i, "existing " + std::to_string(i)));
+
+    // Back-filled days interleave with existing ones; every fifth day conflicts.
+    std::vector<Entry> batch {};
+    for (int i {-3}; i < 70; i += 5)
+        batch.push_back(make(start + days{i}, 100. + i, "merged"));
+
+    auto replaced = rec, kept = rec, expected = rec;
+    for (auto const& e: batch)
+        expected.update(e);
+    replaced.merge(batch);
+    assert(replaced == expected);
+    for (int i {0}; i < replaced.size(); ++i)
+        assert(replaced[i].notes() == expected[i].notes());
+
+    kept.merge(batch, Record::Conflict::KeepExisting);
+    assert(kept.size() == expected.size());
+    for (int i {0}; i < kept.size(); ++i) {
+        auto const existing = rec.get(kept[i].date());
+        auto const& source = existing ? *existing : expected[i];
+        assert(kept[i].notes() == source.notes());
+        assert(std::ranges::equal(kept[i].metrics(), source.metrics()));
+    }
+
+    // Lookups, summaries, and rollups see the merged entries.
+    DateRange const all {};
+    for (auto const& e: batch)
+        assert(replaced.find(e.date()) && replaced.metrics(e.date())->front() == e.metrics().front());
+    std::vector<Entry> copies {};
+    for (auto const& e: replaced)
+        copies.push_back(e.to_entry());
+    Record const fresh { copies };
+    assert(replaced.summarize(all)->mean == fresh.summarize(all)->mean);
+    assert(replaced.rollup(ewi::CalendarPeriod::Month).means == fresh.rollup(ewi::CalendarPeriod::Month).means);
+
+    // Appending in bulk is a merge too.
+    auto appended = rec;
+    std::vector<Entry> const tail { make(start + days{100}, 1., ""), make(start + days{101}, 2., "") };
+    appended.merge(tail);
+    assert(appended.size() == rec.size() + 2 && appended.find(Date{ start + days{101} }) == rec.size() + 1);
+
+    // Rejected batches leave the record untouched.
+    auto const version = rec.version();
+    auto const before = rec;
+    auto rejects = [&](std::vector<Entry> const& entries, Record::Conflict policy) -> bool {
+        try {
+            rec.merge(entries, policy);
+        } catch (...) {
+            return true;
+        }
+        return false;
+    };
+    assert(rejects(batch, Record::Conflict::Throw));
+    assert(rejects({ make(start + days{5}, 1., ""), make(start + days{3}, 1., "") }, Record::Conflict::Replace));
+    assert(rejects({ Entry(Date{ start + days{7} }, "", std::vector<double>{ 1. }) }, Record::Conflict::Replace));
+    assert(rec == before && rec.version() == version);
+
+    // A batch without conflicts merges under any policy.
+    std::vector<Entry> const odd_days { make(start + days{1}, 1., ""), make(start + days{3}, 3., "") };
+    rec.merge(odd_days, Record::Conflict::Throw);
+    assert(rec.size() == before.size() + 2 && rec.version() != version);
+    assert(rec.find(Date{ start + days{3} }) == 3);
+}
+
+/// Range and bulk removal must match removing the entries one at a time.
+void test_bulk_removal()
+{
+    using namespace std::chrono;
+    Record rec {};
+    sys_days const start { 2023y / January / 1d };
+    for (int i {0}; i < 400; ++i)
+        rec.add(Entry(Date{ start + days{i} }, (i % 3) ? "" : "note " + std::to_string(i),
+                    std::vector<double>{ double(i % 9), double(i) }));
+    auto one_by_one = [](Record copy, std::vector<Date> const& dates) -> Record {
+        for (auto d: dates)
+            copy.remove(d);
+        return copy;
+    };
+    auto check = [](Record const& actual, Record const& expected) {
+        assert(actual == expected);
+        for (int i {0}; i < actual.size(); ++i)
+            assert(actual[i].notes() == expected[i].notes() && actual.find(actual[i].date()) == i);
+        DateRange const all {};
+        if (!expected.is_empty()) {
+            assert(actual.summarize(all)->mean == expected.summarize(all)->mean);
+            assert(actual.rollup(ewi::CalendarPeriod::Month).means == expected.rollup(ewi::CalendarPeriod::Month).means);
+        }
+    };
+
+    // Retention: drop everything before a cutoff.
+    Date const cutoff { 2023y / September / 30d };
+    std::vector<Date> old_dates {};
+    for (auto const& e: rec)
+        if (e.date() <= cutoff)
+            old_dates.push_back(e.date());
+    rec.summarize(DateRange{});  // copies carry the cumulative sums, which must be invalidated
+    auto retained = rec;
+    retained.remove(DateRange{ .max=cutoff });
+    check(retained, one_by_one(rec, old_dates));
+    assert(retained.size() == rec.size() - static_cast<int>(old_dates.size()));
+
+    // A range in the middle, and ranges without entries.
+    auto middle = rec;
+    middle.remove(DateRange{ Date{ 2023y / March / 5d }, Date{ 2023y / April / 2d } });
+    assert(middle.size() == rec.size() - 29 && !middle.find(2023y / March / 20d));
+    auto const version = middle.version();
+    middle.remove(DateRange{ Date{ 2020y / January / 1d }, Date{ 2020y / December / 31d } });
+    middle.remove(DateRange{ Date{ 2023y / April / 2d }, Date{ 2023y / March / 5d } });
+    assert(middle.version() == version);
+
+    // Scattered dates, unordered, with duplicates and dates that have no entry.
+    std::vector<Date> scattered {};
+    for (int i {399}; i >= 0; i -= 7)
+        scattered.push_back(Date{ start + days{i} });
+    scattered.push_back(scattered.front());
+    scattered.push_back(Date{ start - days{30} });
+    auto bulk = rec;
+    bulk.remove(std::span<Date const>{ scattered });
+    check(bulk, one_by_one(rec, scattered));
+    assert(bulk.size() == rec.size() - 58);
+
+    // Removing everything.
+    auto emptied = rec;
+    emptied.remove(DateRange{});
+    assert(emptied.is_empty() && emptied.begin() == emptied.end());
+    emptied.add(Entry(Date{ start }, "", std::vector<double>{ 1. }));
+    assert(emptied.metric_dim() == 1);
+}
+
+/// Dates that are not `ok()` are rejected by every way of inserting entries.
+void test_invalid_dates()
+{
+    using namespace std::chrono;
+    Date const invalid { 2023y / February / 30d };
+    Date const before { 2023y / February / 28d }, after { 2023y / March / 2d };
+    auto throws = [](auto&& insert) -> bool {
+        try {
+            insert();
+        } catch (...) {
+            return true;
+        }
+        return false;
+    };
+
+    Record rec {};
+    rec.add(Entry(before, "", METRICS));
+    auto const expected = rec;
+    auto const version = rec.version();
+    assert(throws([&]{ rec.add(Entry(invalid, "", METRICS)); }));
+    assert(throws([&]{ rec.emplace(invalid, "", METRICS); }));
+    assert(throws([&]{ rec.update(Entry(invalid, "", METRICS)); }));
+    std::vector<Entry> const batch { Entry(invalid, "", METRICS), Entry(after, "", METRICS) };
+    assert(throws([&]{ rec.merge(batch); }));
+    assert(rec == expected && rec.version() == version);
+
+    // Had it been inserted, February 30th would have been found as March 2nd.
+    rec.add(Entry(after, "", METRICS));
+    assert(rec.find(after) == 1 && !rec.find(invalid));
+
+    std::vector<Entry> entries { Entry(before, "", METRICS), Entry(invalid, "", METRICS) };
+    assert(throws([&]{ Record{ entries }; }));
+    assert(throws([&]{
+        ewi::RecordColumns columns {};
+        columns.dates = { before, invalid };
+        columns.note_offsets = { 0, 0, 0 };
+        Record{ std::move(columns) };
+    }));
 }
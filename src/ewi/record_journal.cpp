@@ -0,0 +1,129 @@
+// record_journal.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "record_journal.hpp"
+//- STL
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <ewi/employee_record.hpp>
+
+
+using cpperrors::Exception;
+namespace fs = std::filesystem;
+namespace ewi
+{
+    RecordJournal::RecordJournal(std::string path, std::uintmax_t threshold)
+        : d_path{ std::move(path) }, d_threshold{ threshold }
+    {
+        std::error_code ec {};
+        auto size = fs::file_size(d_path, ec);
+        d_size = ec ? 0 : size;
+    }
+
+    void RecordJournal::replay(EmployeeRecord& rec) const
+    {
+        std::ifstream file {d_path};
+        if (!file.is_open())
+            return;  // Nothing was journaled.
+
+        std::string line {};
+        std::istringstream iss {};
+        while (std::getline(file, line))
+        {
+            if (line.empty())
+                continue;
+            iss.clear();
+            iss.str(line);
+
+            using IO = EmployeeRecordIOUtils;
+            auto job = IO::parse_job(iss);
+            auto type = IO::parse_recordtype(iss);
+            auto date = IO::parse_date(iss);
+            auto notes = IO::parse_notes(iss);
+            auto metrics = IO::parse_metrics(iss);
+
+            // Skip Entries that made it into the record file before the journal was
+            // truncated.
+            auto const& wi_rec = rec.get_mut(job);
+            auto const& target = (type == RecordType::Technical) ? wi_rec.technical : wi_rec.personal;
+            if (target.find(date))
+                continue;
+            rec.emplace(job, type, date, notes, metrics);
+        }
+        if (file.bad())
+            throw Exception("Could not read journal: " + d_path);
+    }
+
+    void RecordJournal::append(JobID const& job, RecordType type, Entry const& entry)
+    {
+        std::ofstream file {d_path, std::ios::app};
+        if (!file.is_open())
+            throw Exception("Could not open journal: " + d_path);
+
+        std::ostringstream line {};
+        EmployeeRecordIOUtils::export_entry(line, entry, job, type);
+        auto const& str = line.str();
+        file.write(str.data(), static_cast<std::streamsize>(str.size()));
+        file.flush();
+        if (!file)
+            throw Exception("Could not write to journal: " + d_path);
+        d_size += str.size();
+    }
+
+    void RecordJournal::compact(std::string const& record_path)
+    {
+        if (d_size == 0)
+            return;
+        std::string contents {};
+        {
+            std::ifstream journal {d_path, std::ios::binary};
+            if (!journal.is_open())
+                throw Exception("Could not open journal: " + d_path);
+            std::ostringstream oss {};
+            oss << journal.rdbuf();
+            contents = oss.str();
+        }
+        if (!fs::exists(record_path))
+            throw Exception("Cannot compact journal; record file does not exist: " + record_path);
+
+        std::ofstream record {record_path, std::ios::binary | std::ios::app};
+        if (!record.is_open())
+            throw Exception("Could not open file: " + record_path);
+        record.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        record.flush();
+        if (!record)
+            throw Exception("Could not write to file: " + record_path);
+
+        clear();
+    }
+
+    void RecordJournal::clear()
+    {
+        std::error_code ec {};
+        fs::remove(d_path, ec);
+        if (ec)
+            throw Exception("Could not clear journal: " + d_path);
+        d_size = 0;
+    }
+} // namespace ewi
@@ -0,0 +1,92 @@
+// record_journal.hpp
+/// An append-only log of the Entries made since an employee's record file was last
+/// written. Appending a line is cheap regardless of how long the employee's history is, so
+/// new survey results are journaled immediately and folded into the record file later.
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_EWI_RECORD_JOURNAL
+#define INCLUDED_EWI_RECORD_JOURNAL
+
+#ifndef INCLUDED_EWI_EMPLOYEE_RECORD
+#include <ewi/employee_record.hpp>
+#endif
+
+#ifndef INCLUDED_STD_CSTDINT
+#include <cstdint>
+#define INCLUDED_STD_CSTDINT
+#endif
+
+#ifndef INCLUDED_STD_STRING
+#include <string>
+#define INCLUDED_STD_STRING
+#endif
+
+namespace ewi
+{
+    /// A journal of Entries for a single employee. Each line is written with
+    /// `EmployeeRecordIOUtils::export_entry`, meaning the journal shares the record file's
+    /// entry format.
+    ///
+    /// Compaction appends the journal to the record file and truncates the journal. The
+    /// record file must therefore be a text record file (see
+    /// `EmployeeRecordIOUtils::export_record`) that already contains every Entry made
+    /// before the journal's first line. Since the importer accepts Entry lines for a job
+    /// in any position, the appended lines need no further processing.
+    class RecordJournal
+    {
+        public:
+            /// Default journal size (in bytes) past which compaction is recommended.
+            static constexpr std::uintmax_t DEFAULT_THRESHOLD { 64 * 1024 };
+
+            // CONSTRUCTORS
+            RecordJournal() = delete;
+            /// Opens the journal at `path`. The file is created on the first append; an
+            /// existing journal (ex. from a session that did not shut down properly) is
+            /// kept as-is.
+            explicit RecordJournal(std::string path, std::uintmax_t threshold=DEFAULT_THRESHOLD);
+
+            // ACCESSORS
+
+            /// Query if the journal has outgrown its threshold.
+            inline auto needs_compaction() const noexcept -> bool { return d_size >= d_threshold; }
+            inline auto path() const noexcept -> std::string const& { return d_path; }
+            /// Query the journal's size in bytes.
+            inline auto size() const noexcept -> std::uintmax_t { return d_size; }
+            /// Adds any journaled Entries missing from `rec` (ex. after a crash). Entries
+            /// whose date already exists in the corresponding Record are skipped.
+            /// Throws exception on I/O or format error.
+            void replay(EmployeeRecord& rec) const;
+
+            // MANIPULATORS
+
+            /// Writes the Entry to the end of the journal and flushes it.
+            /// Throws exception on I/O error.
+            void append(JobID const& job, RecordType type, Entry const& entry);
+            /// Folds the journal into the record file at `record_path` and empties the
+            /// journal. Does nothing if the journal is empty.
+            /// Throws exception on I/O error; the journal is left intact in that case.
+            void compact(std::string const& record_path);
+            /// Discards the journal's contents.
+            void clear();
+
+        private:
+            std::string d_path;
+            std::uintmax_t d_threshold;
+            std::uintmax_t d_size {};
+    };
+} // namespace ewi
+#endif // INCLUDED_EWI_RECORD_JOURNAL
@@ -0,0 +1,114 @@
+// record_journal.t.cpp
+// RecordJournal Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "record_journal.hpp"
+//- STL
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+//- Third-party
+#include <cpperrors>
+//- In-house
+#include <ewi/employee_record.hpp>
+
+using namespace ewi;
+using namespace std::chrono_literals;
+
+void test_append_and_compact();
+void test_replay();
+
+int main()
+{
+    try {
+        test_append_and_compact();
+        test_replay();
+    } catch (cpperrors::Exception const& e) {
+        std::cerr << e.report(true) << "\n";
+        throw;
+    }
+}
+//--------------------------------------------------------------------------------------------------
+namespace
+{
+    Employee const PERSON { EmployeeID{ "00042" }, "Daffy Duck" };
+    JobID const JOB { "1937" };
+
+    auto entry_on(std::chrono::day d) -> Entry
+    {
+        return Entry(2024y / std::chrono::November / d, "Journaled\nnotes", std::vector<double>{ 1., 2.5 });
+    }
+}
+
+/// Entries journaled and compacted into the record file must be read back by the importer.
+void test_append_and_compact()
+{
+    std::string const record_path { "daffy_record.txt" };
+    std::string const journal_path { "daffy.journal" };
+    std::filesystem::remove(journal_path);
+
+    EmployeeRecord rec { PERSON };
+    rec.add(JOB, RecordType::Technical, entry_on(1d));
+    EmployeeRecordIOUtils::export_record(rec, record_path);
+
+    RecordJournal journal { journal_path, 1 };
+    assert(journal.size() == 0 && !journal.needs_compaction());
+    for (auto d : { 2d, 3d, 4d }) {
+        rec.add(JOB, RecordType::Technical, entry_on(d));
+        journal.append(JOB, RecordType::Technical, entry_on(d));
+    }
+    rec.add(JOB, RecordType::Personal, entry_on(4d));
+    journal.append(JOB, RecordType::Personal, entry_on(4d));
+    assert(journal.size() > 0 && journal.needs_compaction());
+
+    journal.compact(record_path);
+    assert(journal.size() == 0 && !std::filesystem::exists(journal_path));
+    assert(EmployeeRecordIOUtils::import_record(record_path) == rec);
+
+    // A reopened journal picks up where the previous one left off.
+    RecordJournal first { journal_path };
+    first.append(JOB, RecordType::Technical, entry_on(5d));
+    RecordJournal second { journal_path };
+    assert(second.size() == first.size());
+    second.clear();
+}
+
+/// Replaying restores journaled Entries without duplicating those already present.
+void test_replay()
+{
+    std::string const journal_path { "daffy_replay.journal" };
+    std::filesystem::remove(journal_path);
+
+    RecordJournal journal { journal_path };
+    for (auto d : { 1d, 2d, 3d })
+        journal.append(JOB, RecordType::Technical, entry_on(d));
+
+    EmployeeRecord expected { PERSON };
+    for (auto d : { 1d, 2d, 3d })
+        expected.add(JOB, RecordType::Technical, entry_on(d));
+
+    // Simulate a crash after the first entry reached the record file.
+    EmployeeRecord recovered { PERSON };
+    recovered.add(JOB, RecordType::Technical, entry_on(1d));
+    journal.replay(recovered);
+    assert(recovered == expected);
+
+    journal.clear();
+}
@@ -24,6 +24,7 @@
 #include <ios>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 //- Third-party
 #include <cpperrors>
@@ -62,7 +63,7 @@ namespace {
 namespace ewi
 {
 
-    SurveyResults::SurveyResults(std::vector<std::string> const& responses, int metric_cnt)
+    SurveyResults::SurveyResults(std::vector<std::string> responses, int metric_cnt)
         : d_metric_cnt{ metric_cnt }, d_responses{ std::move(responses) } 
     {
         // 3 is the minimum length of a valid survey result std::vector.
@@ -71,9 +72,9 @@ namespace ewi
         assert(static_cast<int>(d_responses.size()) > 2); // must have at least three elements
     }
 
-    auto SurveyResults::extract_metrics() const -> std::vector<double> const
+    auto SurveyResults::extract_metrics() const -> MetricVector
     {
-        std::vector<double> metrics {};
+        MetricVector metrics {};
 
         // Only the first and last elements of the responses vector are non-numeric.
         // We skip those as a result.
@@ -201,7 +202,7 @@ namespace ewi
 
     auto SurveyResults::to_entry() const -> Entry
     {
-        auto answers = get_responses();
+        auto const& answers = get_responses();
         // Date
         std::istringstream iss { answers[0] };
         std::chrono::year_month_day date;
@@ -214,6 +215,6 @@ namespace ewi
         // Metrics
         auto metrics = extract_metrics();
 
-        return Entry {date, notes, metrics};
+        return Entry {date, std::move(notes), std::move(metrics)};
     }
 } // namespace ewi
@@ -34,9 +34,12 @@
 #include <ewi/basic_id.hpp>
 #endif
 
+#ifndef INCLUDED_EWI_ENTRY
+#include <ewi/entry.hpp>
+#endif
+
 namespace ewi
 {
-    class Entry;
     struct Job 
     {
         BasicID id;
@@ -106,12 +109,12 @@ namespace ewi
     {
         public:
             // CONSTRUCTORS
-            SurveyResults(std::vector<std::string> const& responses, int metric_cnt);
+            SurveyResults(std::vector<std::string> responses, int metric_cnt);
 
             // ACCESSORS
             inline auto get_responses() const -> std::vector<std::string> const& { return d_responses; }
             inline auto metric_cnt() const -> int { return d_metric_cnt; }
-            auto extract_metrics() const -> std::vector<double> const;
+            auto extract_metrics() const -> MetricVector;
             auto to_entry() const -> Entry;
         private:
             SurveyResults() = delete;
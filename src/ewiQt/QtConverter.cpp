@@ -18,7 +18,6 @@
 #include "QtConverter.hpp"
 //- STL
 #include <chrono>
-#include <sstream>
 #include <string>
 #include <vector>
 //- Third-party
@@ -37,14 +36,20 @@ namespace ewiQt
     // https://en.cppreference.com/w/cpp/chrono/year_month_day/formatter
     std::string const QtConverter::STL_DATE_FORMAT { "%Y-%m-%d" };   
 
+    // Dates are converted field by field; no strings are involved. Qt's calendar has no
+    // year zero (1 BCE is year -1) whereas `std::chrono` counts 1 BCE as year 0.
     auto QtConverter::to_stl(QDate const& date) -> std::chrono::year_month_day
     {
-        std::string date_string { date.toString(QT_DATE_FORMAT).toStdString() };
-        std::istringstream iss { date_string };
-        std::chrono::year_month_day stl_date;
-        std::chrono::from_stream(iss, STL_DATE_FORMAT.c_str(), stl_date);
-
-        return stl_date;
+        if (!date.isValid())
+            return std::chrono::year_month_day{};
+        int year { date.year() };
+        if (year < 0)
+            ++year;
+        return std::chrono::year_month_day{
+            std::chrono::year{ year },
+            std::chrono::month{ static_cast<unsigned>(date.month()) },
+            std::chrono::day{ static_cast<unsigned>(date.day()) }
+        };
     }
 
     auto QtConverter::to_stl(QVector<QDate> const& dates) -> std::vector<std::chrono::year_month_day>
@@ -58,11 +63,12 @@ namespace ewiQt
 
     auto QtConverter::toQt(std::chrono::year_month_day const& date) -> QDate
     {
-        std::ostringstream oss {};
-        oss << date;
-        QString qtDateString = QString::fromStdString(oss.str());
-
-        return QDate::fromString(qtDateString, QT_DATE_FORMAT);
+        if (!date.ok())
+            return QDate{};
+        int year { static_cast<int>(date.year()) };
+        if (year <= 0)
+            --year;
+        return QDate{ year, static_cast<int>(static_cast<unsigned>(date.month())), static_cast<int>(static_cast<unsigned>(date.day())) };
     }
 
     auto QtConverter::toQt(std::vector<std::chrono::year_month_day> const& dates) -> QVector<QDate>
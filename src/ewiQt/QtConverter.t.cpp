@@ -63,6 +63,13 @@ void test_date()
 
     assert(STL_DATE == QtC::to_stl(QT_DATE));
     assert(QT_DATE == QtC::toQt(STL_DATE));
+
+    // Round trip across the proleptic calendar, including leap days and BCE years.
+    for (auto const& date: { year_month_day{ 2024y, February, 29d }, year_month_day{ 1y, January, 1d },
+            year_month_day{ 0y, March, 1d }, year_month_day{ -44y, March, 15d } })
+        assert(QtC::to_stl(QtC::toQt(date)) == date);
+    assert(QtC::toQt(year_month_day{ 0y, January, 1d }) == QDate(-1, 1, 1));
+    assert(!QtC::toQt(year_month_day{ 2023y, February, 29d }).isValid());
 }
 
 void test_dates()
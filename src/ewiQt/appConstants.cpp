@@ -30,6 +30,7 @@ using QtC = ewiQt::QtConverter;
 namespace ewiQt
 {
     QString const AppConstants::FILE_EXT { ".txt" };
+    QString const AppConstants::JOURNAL_EXT { ".journal" };
     QString const AppConstants::USR_DIR { ".usr" };
     QString const AppConstants::TMP_DIR { ".tmp" };
     QString const AppConstants::JOB_DIR { ".jobs" };
@@ -52,6 +53,14 @@ namespace ewiQt
     {
         return getUserPath(QtC::toQt(user_id));
     }
+    auto AppConstants::getJournalPath(QString const& userID) -> QString
+    {
+        return getTmpDir() + '/' + userID + JOURNAL_EXT;
+    }
+    auto AppConstants::getJournalPath(std::string const& user_id) -> QString
+    {
+        return getJournalPath(QtC::toQt(user_id));
+    }
     auto AppConstants::getTmpDir() -> QString
     {
         return getExeDir() + '/' + TMP_DIR;
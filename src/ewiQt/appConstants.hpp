@@ -36,6 +36,7 @@ namespace ewiQt
     struct AppConstants
     {
         static QString const FILE_EXT;
+        static QString const JOURNAL_EXT;
         // Internal App Directories
         static QString const USR_DIR; // Stores user profiles
         static QString const TMP_DIR; // For internal operations
@@ -49,6 +50,9 @@ namespace ewiQt
         /// Get the path to the user profile.
         static auto getUserPath(QString const& userID) -> QString;
         static auto getUserPath(std::string const& user_id) -> QString;
+        /// Get the path to the user's entry journal (within the temporary directory).
+        static auto getJournalPath(QString const& userID) -> QString;
+        static auto getJournalPath(std::string const& user_id) -> QString;
         /// Get path to temporary directory
         static auto getTmpDir() -> QString;
         /// Get path to job directory
@@ -20,6 +20,7 @@
 #include <cassert>
 #include <chrono>
 #include <optional>
+#include <span>
 #include <thread>  // for sleeping
 #include <vector>
 //- Third-party
@@ -113,6 +114,22 @@ void EWIController::createConnections()
     connect(d_app, &EWIUi::surveyResponsesSig, this, &EWIController::processResponses);
 }
 
+void EWIController::openJournal()
+{
+    assert(d_user_profile);
+    d_journal.emplace(QtC::to_stl(AC::getJournalPath(d_user_profile->who().id.formal())));
+}
+
+void EWIController::saveUser()
+{
+    assert(d_user_profile);
+    QString userFile { AC::getUserPath(d_user_profile->who().id.formal()) };
+    if (d_journal && QFile::exists(userFile))
+        d_journal->compact(QtC::to_stl(userFile));
+    else
+        ewi::EmployeeRecordIOUtils::export_record_incremental(*d_user_profile, QtC::to_stl(userFile));
+}
+
 void EWIController::sendError(std::string const& err_msg)
 {
     emit d_app->errorMsgSig(QString::fromStdString(err_msg));
@@ -151,8 +168,8 @@ void EWIController::validateRuntimeEnv()
 // TODO: Remove after implementation is complete.
 void EWIController::appShutdown()
 {
-    if (d_profile_loaded)
-        exportUser(AC::getUserPath(d_user_profile->who().id.formal()));
+    if (d_user_profile)
+        saveUser();
     // Delete tmp 
     QDir tmpDir { AC::getTmpDir() };
     bool test = tmpDir.removeRecursively();
@@ -181,11 +198,15 @@ void EWIController::createUser(QStringList userData)
 
     // Save the user current loaded
     if (d_user_profile)
-        exportUser(AC::getUserPath(d_user_profile->who().id.formal()));
+        saveUser();
 
     auto data = QtC::to_stl(userData);
     ewi::Employee emp { { data[0] }, data[1] };
     d_user_profile = ewi::EmployeeRecord { emp };
+    // Write the (empty) record now so that journaled entries can be folded into it.
+    ewi::EmployeeRecordIOUtils::export_record_incremental(*d_user_profile, QtC::to_stl(userFile));
+    openJournal();
+    d_journal->clear();  // Discard anything left behind by a deleted user of the same ID.
     
     // Send signal that profile is loaded if necessary
     if (!d_profile_loaded && d_job_profile)
@@ -229,12 +250,23 @@ void EWIController::loadUser(QString userID)
 {
     // if user already loaded, save any changes
     if (d_user_profile)
-        exportUser(AC::getUserPath(d_user_profile->who().id.formal()));
+        saveUser();
     // Let's assume the data is formed correctly.
     QString userFile { AC::getUserPath(userID) };
     try 
     {
-       d_user_profile = ewi::EmployeeRecordIOUtils::import_record(QtC::to_stl(userFile));
+       // Jobs are parsed on first access, so only the active job's history is read.
+       d_user_profile = ewi::EmployeeRecordIOUtils::import_record_lazy(QtC::to_stl(userFile));
+       openJournal();
+       // A non-empty journal means the previous session ended before the journal was
+       // folded into the user's file. Recover the entries and rewrite the file; only
+       // the jobs they touched are reformatted.
+       if (d_journal->size() > 0)
+       {
+           d_journal->replay(*d_user_profile);
+           ewi::EmployeeRecordIOUtils::export_record_incremental(*d_user_profile, QtC::to_stl(userFile));
+           d_journal->clear();
+       }
     }
     catch (Exception const& e) 
     {
@@ -284,7 +316,7 @@ void EWIController::processMetrics(QVector<QDate> dates)
                 tech_title
             };
             // get metrics 
-            auto const rec = wi_rec.technical;
+            auto const& rec = wi_rec.technical;
             auto metrics = rec.metrics({ stl_dates[0], stl_dates[1] });
             if (!metrics)
             {
@@ -294,10 +326,9 @@ void EWIController::processMetrics(QVector<QDate> dates)
                 sendError(oss.str());
                 return;
             }
-            // Eigen processing
-            Eigen::MatrixXd tech_matrix = ewi::to_eigen(*metrics);
-            Eigen::VectorXd tech_means = ewi::get_means(tech_matrix);
-            Eigen::VectorXd global_tech_means = ewi::to_eigen(d_job_profile->averages);
+            // Eigen processing (the metrics are mapped in place, not copied)
+            Eigen::VectorXd tech_means = ewi::get_means(ewi::as_eigen(*metrics));
+            auto global_tech_means = ewi::as_eigen(std::span<double const>{ d_job_profile->averages });
             auto temp_twi = ewi::calculate_ewi(tech_means, global_tech_means);
 
             // Update options (set ylim)
@@ -316,7 +347,7 @@ void EWIController::processMetrics(QVector<QDate> dates)
                 auto const& p_metrics = wi_rec.personal.metrics( { stl_dates[0], stl_dates[1] } );
                 if (p_metrics)
                 {
-                    double p_mean = ewi::to_eigen(*p_metrics).mean();
+                    double p_mean = ewi::as_eigen(*p_metrics).mean();
                     double pwi = ewi::calculate_ewi(
                             p_mean,
                             ewi::PersonalSurvey::IDEAL_MEAN,
@@ -370,13 +401,17 @@ void EWIController::processResponses(QStringList responses, QString const& surve
     // Create the entry and update the record
     try
     {
-        if (surveyType == d_app->TECHNICAL_SURVEY)
-            d_user_profile->add( d_job_profile->job_label.id, ewi::RecordType::Technical, results.to_entry() );
-        else
-            d_user_profile->add( d_job_profile->job_label.id, ewi::RecordType::Personal, results.to_entry() );
+        auto const& job = d_job_profile->job_label.id;
+        auto type = (surveyType == d_app->TECHNICAL_SURVEY) 
+            ? ewi::RecordType::Technical 
+            : ewi::RecordType::Personal;
+        auto entry = results.to_entry();
+        d_user_profile->add(job, type, entry);
 
-        // TODO: Marking temp file update point.
-        // export_entry(results.to_entry); to the relevant file.
+        // Journal the entry so it survives a crash without rewriting the user's file.
+        d_journal->append(job, type, entry);
+        if (d_journal->needs_compaction())
+            saveUser();
     }
     catch (Exception const& e)
     {
@@ -38,6 +38,10 @@
 #include <ewi/employee_record.hpp>
 #endif
 
+#ifndef INCLUDED_EWI_RECORD_JOURNAL
+#include <ewi/record_journal.hpp>
+#endif
+
 #ifndef INCLUDED_EWI_SURVEY
 #include <ewi/survey.hpp>
 #endif
@@ -79,10 +83,18 @@ private:  /* DATA MEMBERS */
     bool d_profile_loaded { false };
     std::optional<ewi::EmployeeRecord> d_user_profile {};
     std::optional<ewi::ParsedProfile> d_job_profile {};
+    /// Entries recorded since the user's file was last written.
+    std::optional<ewi::RecordJournal> d_journal {};
     ewiQt::EWIUi* d_app {};
 
 private:  /* METHODS */
     void createConnections();
+    /// Open the current user's entry journal.
+    void openJournal();
+    /// Fold the current user's journaled entries into their file. Falls back to an
+    /// incremental export (which writes nothing if the user is unchanged) if there is no
+    /// journal or the file does not exist yet.
+    void saveUser();
     void sendError(std::string const& err_msg);
     /// Ensure required directories are available to the program.
     /// Assumes this program is self-contained in that critical files are stored within the
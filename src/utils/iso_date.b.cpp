@@ -0,0 +1,146 @@
+// iso_date.b.cpp
+// IsoDate Microbenchmark Driver
+//
+// Usage: bench_iso_date [num_dates]
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "iso_date.hpp"
+//- STL
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using utils::IsoDate;
+using Clock = std::chrono::steady_clock;
+using namespace std::chrono;
+
+namespace
+{
+    /// The `std::from_chars` parser `EmployeeRecordIOUtils::parse_date` used previously.
+    auto parse_from_chars(std::string_view str) -> year_month_day
+    {
+        int y {};
+        unsigned m {}, d {};
+        char const* const end = str.data() + str.size();
+        auto res = std::from_chars(str.data(), end, y);
+        res = std::from_chars(res.ptr + 1, end, m);
+        std::from_chars(res.ptr + 1, end, d);
+        return year_month_day{ year{y}, month{m}, day{d} };
+    }
+
+    template<typename F>
+    auto time_best_of(int runs, F&& f) -> double
+    {
+        double best { 1e300 };
+        for (int i {0}; i < runs; ++i)
+        {
+            auto start = Clock::now();
+            f();
+            duration<double> elapsed = Clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    void report(char const* label, double secs, int count, double baseline)
+    {
+        std::cout << "  " << label << ": " << secs * 1e9 / count << " ns/date ("
+            << baseline / secs << "x)\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int const count { argc > 1 ? std::atoi(argv[1]) : 1'000'000 };
+    std::vector<year_month_day> dates {};
+    std::vector<std::string> strings {};
+    dates.reserve(count);
+    strings.reserve(count);
+    sys_days day { 1900y / January / 1d };
+    for (int i {0}; i < count; ++i, day += days{ (i * 7919) % 3 })
+    {
+        dates.emplace_back(day);
+        strings.push_back(std::format("{:%F}", dates.back()));
+    }
+
+    // Parsing
+    std::cout << "<parse> " << count << " dates\n";
+    long checksum {};
+    auto const stream_s = time_best_of(3, [&] {
+        std::istringstream iss {};
+        for (auto const& s: strings) {
+            iss.clear();
+            iss.str(s);
+            year_month_day date {};
+            from_stream(iss, "%Y-%m-%d", date);
+            checksum += static_cast<unsigned>(date.day());
+        }
+    });
+    auto const chars_s = time_best_of(3, [&] {
+        for (auto const& s: strings)
+            checksum += static_cast<unsigned>(parse_from_chars(s).day());
+    });
+    auto const iso_s = time_best_of(3, [&] {
+        for (auto const& s: strings)
+            checksum += static_cast<unsigned>(IsoDate::parse(s)->day());
+    });
+    report("from_stream   ", stream_s, count, stream_s);
+    report("from_chars    ", chars_s, count, stream_s);
+    report("IsoDate::parse", iso_s, count, stream_s);
+
+    // Formatting
+    std::cout << "<format> " << count << " dates\n";
+    std::string out {};
+    out.reserve(static_cast<std::size_t>(count) * (IsoDate::WIDTH + 1));
+    auto const ostream_s = time_best_of(3, [&] {
+        std::ostringstream oss {};
+        for (auto const& d: dates)
+            oss << d << ' ';
+        checksum += static_cast<long>(oss.str().size());
+    });
+    auto const format_s = time_best_of(3, [&] {
+        out.clear();
+        for (auto const& d: dates) {
+            out += std::format("{:%F}", d);
+            out += ' ';
+        }
+    });
+    std::string const expected { out };
+    auto const iso_format_s = time_best_of(3, [&] {
+        out.clear();
+        std::array<char, IsoDate::WIDTH + 1> buf {};
+        buf.back() = ' ';
+        for (auto const& d: dates) {
+            IsoDate::format(d, buf.data());
+            out.append(buf.data(), buf.size());
+        }
+    });
+    assert(out == expected);
+    report("operator<<     ", ostream_s, count, ostream_s);
+    report("std::format    ", format_s, count, ostream_s);
+    report("IsoDate::format", iso_format_s, count, ostream_s);
+
+    std::cout << "(checksum " << checksum << ")\n";
+}
@@ -0,0 +1,35 @@
+// iso_date.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "iso_date.hpp"
+//- STL
+#include <chrono>
+#include <format>
+#include <string>
+
+
+namespace utils
+{
+    auto IsoDate::to_string(std::chrono::year_month_day date) -> std::string
+    {
+        if (!is_formattable(date))
+            return std::format("{:%F}", date);
+        std::string str (WIDTH, '\0');
+        format(date, str.data());
+        return str;
+    }
+} // namespace utils
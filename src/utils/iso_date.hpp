@@ -0,0 +1,135 @@
+// iso_date.hpp
+/// Fixed-width `YYYY-MM-DD` date conversion without streams, locales, or allocation.
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_ISO_DATE
+#define INCLUDED_ISO_DATE
+
+#ifndef INCLUDED_STD_CHRONO
+#include <chrono>
+#define INCLUDED_STD_CHRONO
+#endif
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_OPTIONAL
+#include <optional>
+#define INCLUDED_STD_OPTIONAL
+#endif
+
+#ifndef INCLUDED_STD_STRING
+#include <string>
+#define INCLUDED_STD_STRING
+#endif
+
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
+namespace utils
+{
+    /// Converts between `std::chrono` dates and the ISO 8601 calendar date format
+    /// `YYYY-MM-DD` (the format of `std::format("{:%F}")` for years 0 through 9999).
+    ///
+    /// Every function is `constexpr`, so dates can be checked at compile time:
+    ///
+    /// ```cpp
+    /// using namespace std::chrono;
+    /// static_assert(IsoDate::parse("2024-11-12") == year_month_day{ 2024y/November/12d });
+    /// ```
+    struct IsoDate
+    {
+        /// Number of characters in a formatted date.
+        static constexpr std::size_t WIDTH { 10 };
+
+        /// Parses a date from exactly `WIDTH` characters. Returns `std::nullopt` if the
+        /// string is not of the form `YYYY-MM-DD` or does not name a real date (ex.
+        /// 2023-02-29).
+        static constexpr auto parse(std::string_view str) noexcept -> std::optional<std::chrono::year_month_day>
+        {
+            if (str.size() != WIDTH || str[4] != '-' || str[7] != '-')
+                return std::nullopt;
+            unsigned const d0 = static_cast<unsigned char>(str[0]) - '0', d1 = static_cast<unsigned char>(str[1]) - '0';
+            unsigned const d2 = static_cast<unsigned char>(str[2]) - '0', d3 = static_cast<unsigned char>(str[3]) - '0';
+            unsigned const d5 = static_cast<unsigned char>(str[5]) - '0', d6 = static_cast<unsigned char>(str[6]) - '0';
+            unsigned const d8 = static_cast<unsigned char>(str[8]) - '0', d9 = static_cast<unsigned char>(str[9]) - '0';
+            // Non-digits wrap around to large values.
+            if ((d0 > 9u) | (d1 > 9u) | (d2 > 9u) | (d3 > 9u) | (d5 > 9u) | (d6 > 9u) | (d8 > 9u) | (d9 > 9u))
+                return std::nullopt;
+            unsigned const y { d0 * 1000 + d1 * 100 + d2 * 10 + d3 };
+            unsigned const m { d5 * 10 + d6 };
+            unsigned const d { d8 * 10 + d9 };
+            if (m - 1 > 11u || d - 1 >= last_day(y, m))
+                return std::nullopt;
+            return std::chrono::year_month_day{
+                std::chrono::year{ static_cast<int>(y) }, std::chrono::month{ m }, std::chrono::day{ d } };
+        }
+        static constexpr auto parse_days(std::string_view str) noexcept -> std::optional<std::chrono::sys_days>
+        {
+            auto date = parse(str);
+            if (!date)
+                return std::nullopt;
+            return std::chrono::sys_days{ *date };
+        }
+
+        /// Query if `format` can represent the date (i.e. it is valid and its year is
+        /// within [0, 9999]).
+        static constexpr auto is_formattable(std::chrono::year_month_day date) noexcept -> bool
+        {
+            return date.ok() && static_cast<int>(date.year()) >= 0 && static_cast<int>(date.year()) <= 9999;
+        }
+        /// Writes the date's `WIDTH` characters to `out` and returns the position past the
+        /// last one. The date must be formattable (see `is_formattable`).
+        static constexpr auto format(std::chrono::year_month_day date, char* out) noexcept -> char*
+        {
+            auto const y = static_cast<unsigned>(static_cast<int>(date.year()));
+            auto const m = static_cast<unsigned>(date.month());
+            auto const d = static_cast<unsigned>(date.day());
+            out[0] = static_cast<char>('0' + y / 1000);
+            out[1] = static_cast<char>('0' + y / 100 % 10);
+            out[2] = static_cast<char>('0' + y / 10 % 10);
+            out[3] = static_cast<char>('0' + y % 10);
+            out[4] = '-';
+            out[5] = static_cast<char>('0' + m / 10);
+            out[6] = static_cast<char>('0' + m % 10);
+            out[7] = '-';
+            out[8] = static_cast<char>('0' + d / 10);
+            out[9] = static_cast<char>('0' + d % 10);
+            return out + WIDTH;
+        }
+        static constexpr auto format(std::chrono::sys_days days, char* out) noexcept -> char*
+        {
+            return format(std::chrono::year_month_day{ days }, out);
+        }
+        /// Formats the date as a string. Dates that are not formattable (see
+        /// `is_formattable`) fall back to `std::format("{:%F}")`.
+        static auto to_string(std::chrono::year_month_day date) -> std::string;
+    private:
+        /// Number of days in month `m` (1-12) of year `y`.
+        static constexpr auto last_day(unsigned y, unsigned m) noexcept -> unsigned
+        {
+            constexpr unsigned char DAYS[12] { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+            bool const leap { y % 4 == 0 && (y % 100 != 0 || y % 400 == 0) };
+            return DAYS[m - 1] + (m == 2 && leap);
+        }
+    };
+} // namespace utils
+#endif // INCLUDED_ISO_DATE
@@ -0,0 +1,74 @@
+// iso_date.t.cpp
+// IsoDate Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "iso_date.hpp"
+//- STL
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <format>
+#include <string>
+#include <string_view>
+
+using utils::IsoDate;
+using namespace std::chrono;
+
+// Compile-time checks
+static_assert(IsoDate::parse("2024-11-12") == year_month_day{ 2024y / November / 12d });
+static_assert(IsoDate::parse("2024-02-29") && !IsoDate::parse("2023-02-29"));
+static_assert(IsoDate::parse_days("1970-01-01") == sys_days{});
+static_assert([] {
+    std::array<char, IsoDate::WIDTH> buf {};
+    IsoDate::format(year_month_day{ 987y / March / 4d }, buf.data());
+    return std::string_view{ buf.data(), buf.size() } == "0987-03-04";
+}());
+
+void test_parse();
+void test_round_trip();
+
+int main()
+{
+    test_parse();
+    test_round_trip();
+}
+//--------------------------------------------------------------------------------------------------
+void test_parse()
+{
+    assert(IsoDate::parse("0000-01-01") == year_month_day{ 0y / January / 1d });
+    assert(IsoDate::parse("9999-12-31") == year_month_day{ 9999y / December / 31d });
+    for (std::string_view bad: { "", "2024-1-12", "2024-01-1", "2024/01/12", "2024-01-12 ", " 2024-01-12",
+            "20a4-01-12", "2024-13-01", "2024-00-10", "2024-04-31", "2024-01-00", "-024-01-12" })
+        assert(!IsoDate::parse(bad));
+}
+
+/// Every day of several centuries must match the standard formatter and parse back.
+void test_round_trip()
+{
+    std::array<char, IsoDate::WIDTH> buf {};
+    for (sys_days day { 1800y / January / 1d }; day <= sys_days{ 2200y / December / 31d }; day += days{1})
+    {
+        year_month_day const date { day };
+        IsoDate::format(date, buf.data());
+        std::string_view const str { buf.data(), buf.size() };
+        assert(str == std::format("{:%F}", date));
+        assert(IsoDate::parse(str) == date);
+        assert(IsoDate::parse_days(str) == day);
+    }
+    assert(IsoDate::to_string(2024y / November / 12d) == "2024-11-12");
+    assert(!IsoDate::is_formattable(year_month_day{ 10000y / January / 1d }));
+}
@@ -0,0 +1,145 @@
+// mapped_file.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "mapped_file.hpp"
+//- STL
+#include <string>
+#include <utility>  // std::exchange
+//- Third-party
+#include <cpperrors>
+//- Platform
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+using cpperrors::Exception;
+namespace utils
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(std::string const& path)
+    {
+        HANDLE file = CreateFileA(
+                path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE)
+            throw Exception("Could not open file: " + path);
+        d_file = file;
+
+        LARGE_INTEGER size {};
+        if (!GetFileSizeEx(file, &size)) {
+            release();
+            throw Exception("Could not query file size: " + path);
+        }
+        d_size = static_cast<std::size_t>(size.QuadPart);
+        if (d_size == 0)
+            return;
+
+        d_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!d_mapping) {
+            release();
+            throw Exception("Could not map file: " + path);
+        }
+        d_data = static_cast<char const*>(MapViewOfFile(d_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!d_data) {
+            release();
+            throw Exception("Could not map file: " + path);
+        }
+    }
+
+    void MappedFile::release() noexcept
+    {
+        if (d_data)
+            UnmapViewOfFile(d_data);
+        if (d_mapping)
+            CloseHandle(d_mapping);
+        if (d_file)
+            CloseHandle(d_file);
+        d_data = nullptr;
+        d_mapping = nullptr;
+        d_file = nullptr;
+        d_size = 0;
+    }
+#else
+    MappedFile::MappedFile(std::string const& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw Exception("Could not open file: " + path);
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw Exception("Could not query file size: " + path);
+        }
+        d_size = static_cast<std::size_t>(info.st_size);
+        if (d_size > 0) {
+            void* addr = ::mmap(nullptr, d_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                d_size = 0;
+                throw Exception("Could not map file: " + path);
+            }
+            d_data = static_cast<char const*>(addr);
+        }
+        // The mapping remains valid after the descriptor is closed.
+        ::close(fd);
+    }
+
+    void MappedFile::release() noexcept
+    {
+        if (d_data)
+            ::munmap(const_cast<char*>(d_data), d_size);
+        d_data = nullptr;
+        d_size = 0;
+    }
+#endif
+
+    MappedFile::~MappedFile() { release(); }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : d_data{ std::exchange(other.d_data, nullptr) },
+          d_size{ std::exchange(other.d_size, 0) }
+#ifdef _WIN32
+          , d_file{ std::exchange(other.d_file, nullptr) },
+          d_mapping{ std::exchange(other.d_mapping, nullptr) }
+#endif
+    {}
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            d_data = std::exchange(other.d_data, nullptr);
+            d_size = std::exchange(other.d_size, 0);
+#ifdef _WIN32
+            d_file = std::exchange(other.d_file, nullptr);
+            d_mapping = std::exchange(other.d_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+} // namespace utils
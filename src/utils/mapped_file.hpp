@@ -0,0 +1,80 @@
+// mapped_file.hpp
+// A read-only, memory-mapped view of a file.
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_MAPPED_FILE
+#define INCLUDED_MAPPED_FILE
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
+#ifndef INCLUDED_STD_STRING
+#include <string>
+#define INCLUDED_STD_STRING
+#endif
+
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
+namespace utils
+{
+    /// Maps an entire file into memory for reading. The mapping lives as long as the
+    /// object, so any span or view obtained from it must not outlive it.
+    ///
+    /// Throws a `cpperrors::Exception` if the file cannot be opened or mapped. An empty
+    /// file is valid and produces an empty view (there is nothing to map).
+    class MappedFile
+    {
+        public:
+            MappedFile() = delete;
+            explicit MappedFile(std::string const& path);
+            ~MappedFile();
+
+            MappedFile(MappedFile const&) = delete;
+            MappedFile& operator=(MappedFile const&) = delete;
+            MappedFile(MappedFile&& other) noexcept;
+            MappedFile& operator=(MappedFile&& other) noexcept;
+
+            inline auto data() const noexcept -> char const* { return d_data; }
+            inline auto size() const noexcept -> std::size_t { return d_size; }
+            inline auto bytes() const noexcept -> std::span<std::byte const>
+            {
+                return { reinterpret_cast<std::byte const*>(d_data), d_size };
+            }
+            inline auto view() const noexcept -> std::string_view { return { d_data, d_size }; }
+
+        private:
+            void release() noexcept;
+
+            char const* d_data {};
+            std::size_t d_size {};
+#ifdef _WIN32
+            void* d_file {};
+            void* d_mapping {};
+#endif
+    };
+} // namespace utils
+#endif // INCLUDED_MAPPED_FILE
@@ -0,0 +1,68 @@
+// mapped_file.t.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "mapped_file.hpp"
+//- STL
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+//- Third-party
+#include <cpperrors>
+
+
+using utils::MappedFile;
+void test_mapping();
+
+int main()
+{
+    test_mapping();
+}
+//--------------------------------------------------------------------------------------------------
+void test_mapping()
+{
+    std::string const CONTENTS { "Line one.\nLine two.\n" };
+    {
+        std::ofstream file { "mapped_file_test.txt", std::ios::binary | std::ios::trunc };
+        file << CONTENTS;
+    }
+    MappedFile mapped { "mapped_file_test.txt" };
+    assert(mapped.size() == CONTENTS.size());
+    assert(mapped.view() == CONTENTS);
+
+    // Moving transfers the mapping.
+    MappedFile moved { std::move(mapped) };
+    assert(mapped.size() == 0 && mapped.data() == nullptr);
+    assert(moved.view() == CONTENTS);
+
+    // Empty files map to an empty view.
+    {
+        std::ofstream file { "mapped_file_empty.txt", std::ios::trunc };
+    }
+    MappedFile empty { "mapped_file_empty.txt" };
+    assert(empty.size() == 0 && empty.view().empty());
+
+    try {
+        MappedFile missing { "this_file_does_not_exist.txt" };
+        assert(false);
+    }
+    catch (cpperrors::Exception const& e)
+    {
+        std::cout << e.what() << "\n";
+    }
+}
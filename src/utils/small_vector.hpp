@@ -0,0 +1,228 @@
+// small_vector.hpp
+/// A vector that stores up to N elements inside the object itself, allocating only when
+/// it grows past them.
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_SMALL_VECTOR
+#define INCLUDED_SMALL_VECTOR
+
+#ifndef INCLUDED_STD_ALGORITHM
+#include <algorithm>
+#define INCLUDED_STD_ALGORITHM
+#endif
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_CSTDINT
+#include <cstdint>
+#define INCLUDED_STD_CSTDINT
+#endif
+
+#ifndef INCLUDED_STD_CSTRING
+#include <cstring>
+#define INCLUDED_STD_CSTRING
+#endif
+
+#ifndef INCLUDED_STD_INITIALIZER_LIST
+#include <initializer_list>
+#define INCLUDED_STD_INITIALIZER_LIST
+#endif
+
+#ifndef INCLUDED_STD_ITERATOR
+#include <iterator>
+#define INCLUDED_STD_ITERATOR
+#endif
+
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
+#ifndef INCLUDED_STD_TYPE_TRAITS
+#include <type_traits>
+#define INCLUDED_STD_TYPE_TRAITS
+#endif
+
+#ifndef INCLUDED_STD_UTILITY
+#include <utility>
+#define INCLUDED_STD_UTILITY
+#endif
+
+namespace utils
+{
+    /// A contiguous, growable sequence (of fewer than 2^32) trivially copyable values
+    /// whose first `N` elements live inside the object. Sequences that fit cost no allocation to create,
+    /// copy, or destroy; longer ones move to the heap like a `std::vector` and stay there
+    /// until destroyed. Iterators are plain pointers and are invalidated by any change in
+    /// size.
+    template<typename T, std::size_t N>
+    class SmallVector
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SmallVector elements are copied bytewise.");
+        static_assert(N > 0, "Use std::vector for sequences without inline storage.");
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using iterator = T*;
+            using const_iterator = T const*;
+
+            // CONSTRUCTORS
+            SmallVector() noexcept {}
+            explicit SmallVector(size_type count, T const& value=T{})
+            {
+                resize(count, value);
+            }
+            explicit SmallVector(std::span<T const> values)
+            {
+                assign(values);
+            }
+            template<std::contiguous_iterator It>
+            SmallVector(It first, It last)
+            {
+                assign(std::span<T const>{ first, last });
+            }
+            SmallVector(std::initializer_list<T> values)
+            {
+                assign(std::span<T const>{ values.begin(), values.size() });
+            }
+            SmallVector(SmallVector const& other)
+            {
+                assign(other);
+            }
+            SmallVector(SmallVector&& other) noexcept
+            {
+                steal(other);
+            }
+            auto operator=(SmallVector const& other) -> SmallVector&
+            {
+                if (this != &other)
+                    assign(other);
+                return *this;
+            }
+            auto operator=(SmallVector&& other) noexcept -> SmallVector&
+            {
+                if (this != &other)
+                {
+                    release();
+                    steal(other);
+                }
+                return *this;
+            }
+            ~SmallVector() { release(); }
+
+            // ACCESSORS
+            inline auto data() noexcept -> T* { return is_inline() ? d_inline : d_heap; }
+            inline auto data() const noexcept -> T const* { return is_inline() ? d_inline : d_heap; }
+            inline auto size() const noexcept -> size_type { return d_size; }
+            inline auto capacity() const noexcept -> size_type { return d_capacity; }
+            inline auto empty() const noexcept -> bool { return d_size == 0; }
+            /// Query if the elements are stored inside the object.
+            inline auto is_inline() const noexcept -> bool { return d_capacity == N; }
+
+            inline auto begin() noexcept -> iterator { return data(); }
+            inline auto end() noexcept -> iterator { return data() + d_size; }
+            inline auto begin() const noexcept -> const_iterator { return data(); }
+            inline auto end() const noexcept -> const_iterator { return data() + d_size; }
+            /// Element access. No bounds checking is performed.
+            inline auto operator[](size_type i) noexcept -> T& { return data()[i]; }
+            inline auto operator[](size_type i) const noexcept -> T const& { return data()[i]; }
+            inline auto front() const noexcept -> T const& { return data()[0]; }
+            inline auto back() const noexcept -> T const& { return data()[d_size - 1]; }
+
+            inline friend auto operator==(SmallVector const& a, SmallVector const& b) noexcept -> bool
+            {
+                return std::ranges::equal(a, b);
+            }
+
+            // MANIPULATORS
+
+            /// Replaces the contents with a copy of `values`, which must not alias them.
+            void assign(std::span<T const> values)
+            {
+                d_size = 0;
+                reserve(values.size());
+                if (!values.empty())
+                    std::memcpy(data(), values.data(), values.size() * sizeof(T));
+                d_size = static_cast<std::uint32_t>(values.size());
+            }
+            void clear() noexcept { d_size = 0; }
+            void push_back(T const& value)
+            {
+                if (d_size == d_capacity)
+                {
+                    T const copy { value };  // `value` may live in the old buffer
+                    reserve(2 * d_capacity);
+                    data()[d_size++] = copy;
+                }
+                else
+                    data()[d_size++] = value;
+            }
+            /// Ensures room for `count` elements without further allocation.
+            void reserve(size_type count)
+            {
+                if (count <= d_capacity)
+                    return;
+                T* grown { new T[count] };
+                if (d_size > 0)
+                    std::memcpy(grown, data(), d_size * sizeof(T));
+                release();
+                d_heap = grown;
+                d_capacity = static_cast<std::uint32_t>(count);
+            }
+            void resize(size_type count, T const& value=T{})
+            {
+                reserve(count);
+                if (count > d_size)
+                    std::fill(data() + d_size, data() + count, value);
+                d_size = static_cast<std::uint32_t>(count);
+            }
+
+        private:
+            void release() noexcept
+            {
+                if (!is_inline())
+                    delete[] d_heap;
+                d_capacity = N;
+            }
+            /// Takes over `other`'s elements, leaving it empty. Expects no heap buffer.
+            void steal(SmallVector& other) noexcept
+            {
+                // Copying the whole (small) buffer compiles to a few moves, unlike a
+                // copy of just the elements in use.
+                if (other.is_inline())
+                    std::memcpy(d_inline, other.d_inline, sizeof(d_inline));
+                else
+                {
+                    d_heap = other.d_heap;
+                    d_capacity = std::exchange(other.d_capacity, std::uint32_t{ N });
+                }
+                d_size = std::exchange(other.d_size, 0);
+            }
+
+            union
+            {
+                T d_inline[N];
+                T* d_heap;  // used once the capacity exceeds N
+            };
+            std::uint32_t d_size {};
+            std::uint32_t d_capacity { N };
+    };
+} // namespace utils
+#endif // INCLUDED_SMALL_VECTOR
@@ -0,0 +1,122 @@
+// small_vector.t.cpp
+// Test Driver for SmallVector
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "small_vector.hpp"
+//- STL
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+using utils::SmallVector;
+void test_inline_storage();
+void test_growth();
+void test_copy_and_move();
+
+int main()
+{
+    test_inline_storage();
+    test_growth();
+    test_copy_and_move();
+}
+//--------------------------------------------------------------------------------------------------
+/// Sequences within the inline capacity never touch the heap.
+void test_inline_storage()
+{
+    SmallVector<double, 4> empty {};
+    assert(empty.empty() && empty.is_inline() && empty.capacity() == 4 && empty.begin() == empty.end());
+
+    SmallVector<double, 4> vals { 1., 2., 3. };
+    assert(vals.size() == 3 && vals.is_inline());
+    assert(vals[0] == 1. && vals.front() == 1. && vals.back() == 3.);
+    auto const* inside = reinterpret_cast<char const*>(&vals);
+    auto const* first = reinterpret_cast<char const*>(vals.data());
+    assert(first >= inside && first < inside + sizeof(vals));
+
+    vals.push_back(4.);
+    assert(vals.is_inline() && vals.size() == 4);
+    std::span<double const> view { vals };
+    assert(view.size() == 4 && view[3] == 4.);
+
+    std::vector<double> const source { 5., 6. };
+    SmallVector<double, 4> from_span { std::span<double const>{ source } };
+    SmallVector<double, 4> from_iters { source.begin(), source.end() };
+    assert(from_span == from_iters && std::ranges::equal(from_span, source));
+
+    vals.resize(2);
+    assert(vals == (SmallVector<double, 4>{ 1., 2. }));
+    vals.clear();
+    assert(vals.empty() && vals.is_inline());
+}
+
+/// Growing past the inline capacity moves the elements to the heap.
+void test_growth()
+{
+    SmallVector<int, 2> vals {};
+    std::vector<int> expected {};
+    for (int i {0}; i < 100; ++i)
+    {
+        vals.push_back(i);
+        expected.push_back(i);
+        assert(vals.is_inline() == (i < 2));
+    }
+    assert(std::ranges::equal(vals, expected) && vals.capacity() >= 100);
+
+    // Pushing an element of the sequence itself survives the reallocation.
+    SmallVector<int, 2> self { 7, 8 };
+    self.push_back(self[0]);
+    assert(self == (SmallVector<int, 2>{ 7, 8, 7 }));
+
+    SmallVector<int, 2> filled (5, 3);
+    assert(filled.size() == 5 && !filled.is_inline() && std::ranges::count(filled, 3) == 5);
+    filled.resize(7);
+    assert(std::ranges::equal(filled, std::vector<int>{ 3, 3, 3, 3, 3, 0, 0 }));
+    filled.reserve(3);
+    assert(filled.size() == 7);
+}
+
+/// Copies are independent; moves take over heap buffers and empty the source.
+void test_copy_and_move()
+{
+    SmallVector<int, 3> small { 1, 2 };
+    SmallVector<int, 3> large { 1, 2, 3, 4, 5 };
+    auto const* buffer = large.data();
+
+    auto small_copy = small, large_copy = large;
+    large_copy[0] = -1;
+    assert(small_copy == small && large[0] == 1 && large_copy.data() != buffer);
+
+    auto moved = std::move(large);
+    assert(moved.data() == buffer && large.empty() && large.is_inline());
+    auto moved_small = std::move(small);
+    assert(moved_small == small_copy && small.empty());
+
+    // Assignment in every direction between inline and heap storage.
+    moved_small = moved;
+    assert(moved_small == moved && !moved_small.is_inline());
+    moved_small = small_copy;
+    assert(moved_small == small_copy);
+    moved = std::move(moved_small);
+    assert(moved == small_copy && moved_small.empty());
+    moved = moved;
+    assert(moved == small_copy);
+    large = std::move(large_copy);
+    assert(large.size() == 5 && large[0] == -1);
+}
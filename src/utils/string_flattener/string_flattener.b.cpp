@@ -0,0 +1,88 @@
+// string_flattener.b.cpp
+// StringFlattener Microbenchmark Driver
+//
+// Usage: bench_string_flattener
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "string_flattener.hpp"
+//- STL
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using Flattener = utils::StringFlattener;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    template<typename F>
+    auto time_best_of(int runs, F&& f) -> double
+    {
+        double best { 1e300 };
+        for (int i {0}; i < runs; ++i)
+        {
+            auto start = Clock::now();
+            f();
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+}
+
+/// Compares the flattener with a character-at-a-time replacement on notes of many
+/// kilobytes.
+int main()
+{
+    std::mt19937 gen { 42 };
+    std::uniform_int_distribution<int> letter { 'a', 'z' };
+    for (std::size_t const kib: { 4u, 64u, 1024u })
+    {
+        std::string notes (kib * 1024, ' ');
+        for (std::size_t i {0}; i < notes.size(); ++i)
+            notes[i] = (i % 73 == 72) ? '\n' : static_cast<char>(letter(gen));
+        int const reps { static_cast<int>(64 * 1024 / kib) };
+
+        std::string scalar {};
+        double const scalar_s = time_best_of(3, [&] {
+            for (int r {0}; r < reps; ++r)
+            {
+                scalar = notes;
+                for (auto& c: scalar)
+                    if (c == '\n')
+                        c = Flattener::SUBTITUTION_STR;
+            }
+        });
+
+        std::string buf {};
+        double const simd_s = time_best_of(3, [&] {
+            for (int r {0}; r < reps; ++r)
+            {
+                buf.clear();
+                Flattener::append_flattened(buf, notes);
+            }
+        });
+        assert(buf == scalar);
+
+        double const mib = static_cast<double>(notes.size()) * reps / (1024. * 1024.);
+        std::cout << "<flatten " << kib << " KiB notes> scalar: " << mib / scalar_s
+            << " MiB/s, flattener: " << mib / simd_s << " MiB/s (" << scalar_s / simd_s << "x)\n";
+    }
+}
@@ -17,14 +17,91 @@
 */
 #include "string_flattener.hpp"
 //- STL
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+#include <ostream>
+#include <span>
 #include <string>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define EWI_FLATTENER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EWI_FLATTENER_SSE2
+#endif
 
 namespace {
-    void replace(std::string& str, char old_c, char new_c)
+    /// Copies `n` bytes from `src` to `dst` (which may be the same), replacing each
+    /// `old_c` with `new_c`.
+    void replace_copy(char const* src, std::size_t n, char* dst, char old_c, char new_c) noexcept
+    {
+        std::size_t i {0};
+#if defined(EWI_FLATTENER_AVX2)
+        __m256i const from = _mm256_set1_epi8(old_c);
+        __m256i const to = _mm256_set1_epi8(new_c);
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+            __m256i const hits = _mm256_cmpeq_epi8(chunk, from);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(chunk, to, hits));
+        }
+#elif defined(EWI_FLATTENER_SSE2)
+        __m128i const from = _mm_set1_epi8(old_c);
+        __m128i const to = _mm_set1_epi8(new_c);
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+            __m128i const hits = _mm_cmpeq_epi8(chunk, from);
+            // (chunk & ~hits) | (to & hits); SSE2 has no byte blend.
+            __m128i const out = _mm_or_si128(_mm_andnot_si128(hits, chunk), _mm_and_si128(hits, to));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+        }
+#endif
+        for (; i < n; ++i)
+            dst[i] = (src[i] == old_c) ? new_c : src[i];
+    }
+
+    auto find_byte(char const* str, std::size_t n, char c) noexcept -> std::size_t
     {
-        for (auto& c: str)
-            if (c == old_c)
-                c = new_c;
+        std::size_t i {0};
+#if defined(EWI_FLATTENER_AVX2)
+        __m256i const target = _mm256_set1_epi8(c);
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i));
+            auto const mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, target)));
+            if (mask)
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+#elif defined(EWI_FLATTENER_SSE2)
+        __m128i const target = _mm_set1_epi8(c);
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i));
+            auto const mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target)));
+            if (mask)
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+#endif
+        for (; i < n; ++i)
+            if (str[i] == c)
+                return i;
+        return std::string_view::npos;
+    }
+
+    void write_replaced(std::string_view str, char old_c, char new_c, std::ostream& os)
+    {
+        for (auto pos = find_byte(str.data(), str.size(), old_c); pos != std::string_view::npos;
+                pos = find_byte(str.data(), str.size(), old_c))
+        {
+            os.write(str.data(), static_cast<std::streamsize>(pos));
+            os.put(new_c);
+            str.remove_prefix(pos + 1);
+        }
+        os.write(str.data(), static_cast<std::streamsize>(str.size()));
     }
 }
 namespace utils
@@ -32,14 +109,83 @@ namespace utils
     auto StringFlattener::flatten(std::string str) -> std::string 
     {
         // str is a copy, so we can mutate it directly.
-        replace(str, StringFlattener::NEWLINE, StringFlattener::SUBTITUTION_STR);
+        flatten_in_place(str);
         return str;
     }
 
     auto StringFlattener::expand(std::string str) -> std::string 
     {
         // str is a copy, so we can mutate it directly.
-        replace(str, StringFlattener::SUBTITUTION_STR, StringFlattener::NEWLINE);
+        expand_in_place(str);
         return str;
     }
+
+    void StringFlattener::flatten_in_place(std::span<char> str) noexcept
+    {
+        ::replace_copy(str.data(), str.size(), str.data(), NEWLINE, SUBTITUTION_STR);
+    }
+
+    void StringFlattener::expand_in_place(std::span<char> str) noexcept
+    {
+        ::replace_copy(str.data(), str.size(), str.data(), SUBTITUTION_STR, NEWLINE);
+    }
+
+    auto StringFlattener::flatten_to(std::string_view str, char* out) noexcept -> char*
+    {
+        return replace_copy(str, NEWLINE, SUBTITUTION_STR, out);
+    }
+
+    auto StringFlattener::expand_to(std::string_view str, char* out) noexcept -> char*
+    {
+        return replace_copy(str, SUBTITUTION_STR, NEWLINE, out);
+    }
+
+    void StringFlattener::append_flattened(std::string& buf, std::string_view str)
+    {
+        auto const pos = buf.size();
+        buf.resize(pos + str.size());
+        flatten_to(str, buf.data() + pos);
+    }
+
+    void StringFlattener::append_expanded(std::string& buf, std::string_view str)
+    {
+        auto const pos = buf.size();
+        buf.resize(pos + str.size());
+        expand_to(str, buf.data() + pos);
+    }
+
+    void StringFlattener::append_flattened(std::pmr::string& buf, std::string_view str)
+    {
+        auto const pos = buf.size();
+        buf.resize(pos + str.size());
+        flatten_to(str, buf.data() + pos);
+    }
+
+    void StringFlattener::append_expanded(std::pmr::string& buf, std::string_view str)
+    {
+        auto const pos = buf.size();
+        buf.resize(pos + str.size());
+        expand_to(str, buf.data() + pos);
+    }
+
+    void StringFlattener::flatten(std::string_view str, std::ostream& os)
+    {
+        write_replaced(str, NEWLINE, SUBTITUTION_STR, os);
+    }
+
+    void StringFlattener::expand(std::string_view str, std::ostream& os)
+    {
+        write_replaced(str, SUBTITUTION_STR, NEWLINE, os);
+    }
+
+    auto StringFlattener::find(std::string_view str, char c) noexcept -> std::size_t
+    {
+        return find_byte(str.data(), str.size(), c);
+    }
+
+    auto StringFlattener::replace_copy(std::string_view str, char old_c, char new_c, char* out) noexcept -> char*
+    {
+        ::replace_copy(str.data(), str.size(), out, old_c, new_c);
+        return out + str.size();
+    }
 } // namespace utils
@@ -19,11 +19,46 @@
 #ifndef INCLUDED_STRING_FLATTENER
 #define INCLUDED_STRING_FLATTENER
 
+#ifndef INCLUDED_STD_ALGORITHM
+#include <algorithm>
+#define INCLUDED_STD_ALGORITHM
+#endif
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_ITERATOR
+#include <iterator>
+#define INCLUDED_STD_ITERATOR
+#endif
+
+#ifndef INCLUDED_STD_MEMORY_RESOURCE
+#include <memory_resource>
+#define INCLUDED_STD_MEMORY_RESOURCE
+#endif
+
+#ifndef INCLUDED_STD_OSTREAM
+#include <ostream>
+#define INCLUDED_STD_OSTREAM
+#endif
+
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
 #ifndef INCLUDED_STD_STRING
 #include <string>
 #define INCLUDED_STD_STRING
 #endif 
 
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
 namespace utils
 {
     struct StringFlattener
@@ -47,6 +82,66 @@ namespace utils
         /// substitution character with a newline sequence. If the string was not
         /// previously compressed, this function returns a copy of the input string.
         static auto expand(std::string str) -> std::string;
+
+        /* Allocation-free variants
+         *
+         * The byte search and replacement is vectorized with AVX2 or SSE2 when the
+         * compiler targets them (ex. `-mavx2`, `/arch:AVX2`; SSE2 is baseline on x86-64)
+         * and falls back to a scalar loop elsewhere.
+         */
+
+        /// Flatten or expand `str` where it lies.
+        static void flatten_in_place(std::span<char> str) noexcept;
+        static void expand_in_place(std::span<char> str) noexcept;
+
+        /// Write the flattened (expanded) `str` to `out`, which must have room for
+        /// `str.size()` characters. Returns the end of the written range.
+        static auto flatten_to(std::string_view str, char* out) noexcept -> char*;
+        static auto expand_to(std::string_view str, char* out) noexcept -> char*;
+
+        /// Append the flattened (expanded) `str` to `buf`.
+        static void append_flattened(std::string& buf, std::string_view str);
+        static void append_expanded(std::string& buf, std::string_view str);
+        static void append_flattened(std::pmr::string& buf, std::string_view str);
+        static void append_expanded(std::pmr::string& buf, std::string_view str);
+
+        /// Write the flattened (expanded) `str` to `os`, one `write` per line of input.
+        static void flatten(std::string_view str, std::ostream& os);
+        static void expand(std::string_view str, std::ostream& os);
+
+        /// Write the flattened (expanded) `str` through an output iterator. Returns the
+        /// iterator past the last character written.
+        template<typename OutputIt>
+            requires std::output_iterator<OutputIt, char>
+        static auto flatten(std::string_view str, OutputIt out) -> OutputIt
+        {
+            return replace_copy(str, NEWLINE, SUBTITUTION_STR, out);
+        }
+        template<typename OutputIt>
+            requires std::output_iterator<OutputIt, char>
+        static auto expand(std::string_view str, OutputIt out) -> OutputIt
+        {
+            return replace_copy(str, SUBTITUTION_STR, NEWLINE, out);
+        }
+
+    private:
+        /// Position of the first `c` in `str` or `std::string_view::npos`.
+        static auto find(std::string_view str, char c) noexcept -> std::size_t;
+        static auto replace_copy(std::string_view str, char old_c, char new_c, char* out) noexcept -> char*;
+
+        /// Copies the runs between occurrences of `old_c` whole rather than character
+        /// by character. (Raw pointers use the vectorized overload above.)
+        template<typename OutputIt>
+        static auto replace_copy(std::string_view str, char old_c, char new_c, OutputIt out) -> OutputIt
+        {
+            for (auto pos = find(str, old_c); pos != std::string_view::npos; pos = find(str, old_c))
+            {
+                out = std::ranges::copy(str.substr(0, pos), out).out;
+                *out++ = new_c;
+                str.remove_prefix(pos + 1);
+            }
+            return std::ranges::copy(str, out).out;
+        }
     };
 } // namespace utils
 #endif // INCLUDED_STRING_FLATTENER
@@ -17,8 +17,14 @@
 */
 #include "string_flattener.hpp"
 //- STL
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <list>
+#include <random>
+#include <sstream>
 #include <string>
+#include <string_view>
 
 std::string const EXPANDED {"Hello\nthis\nis\na\nreally\nspaced\nstring."};
 std::string const COMPRESSED {"Hello\u0001this\u0001is\u0001a\u0001really\u0001spaced\u0001string."};
@@ -26,10 +32,16 @@ std::string const INCOMPRESSIBLE {"Hi."};
 
 using Flattener = utils::StringFlattener;
 void test_flatten();
+void test_overloads();
+void test_boundaries();
+void test_long_notes();
 
 int main()
 {
     test_flatten();
+    test_overloads();
+    test_boundaries();
+    test_long_notes();
 }
 //--------------------------------------------------------------------------------------------------
 void test_flatten()
@@ -42,3 +54,77 @@ void test_flatten()
     assert(Flattener::flatten(INCOMPRESSIBLE) == INCOMPRESSIBLE);
     assert(Flattener::expand(INCOMPRESSIBLE) == INCOMPRESSIBLE);
 }
+
+void test_overloads()
+{
+    std::string in_place { EXPANDED };
+    Flattener::flatten_in_place(in_place);
+    assert(in_place == COMPRESSED);
+    Flattener::expand_in_place(in_place);
+    assert(in_place == EXPANDED);
+
+    std::string buf { "prefix " };
+    Flattener::append_flattened(buf, EXPANDED);
+    assert(buf == "prefix " + COMPRESSED);
+    buf.clear();
+    Flattener::append_expanded(buf, COMPRESSED);
+    assert(buf == EXPANDED);
+
+    std::ostringstream oss {};
+    Flattener::flatten(std::string_view{ EXPANDED }, oss);
+    assert(oss.str() == COMPRESSED);
+    oss.str("");
+    Flattener::expand(std::string_view{ COMPRESSED }, oss);
+    assert(oss.str() == EXPANDED);
+
+    std::string out {};
+    Flattener::flatten(std::string_view{ EXPANDED }, std::back_inserter(out));
+    assert(out == COMPRESSED);
+    std::list<char> chars {};
+    Flattener::expand(std::string_view{ COMPRESSED }, std::back_inserter(chars));
+    assert(std::ranges::equal(chars, EXPANDED));
+
+    std::string raw (EXPANDED.size(), '\0');
+    assert(Flattener::flatten_to(EXPANDED, raw.data()) == raw.data() + raw.size());
+    assert(raw == COMPRESSED);
+}
+
+/// Vectorized and scalar paths must agree for every length and newline position around
+/// the vector widths.
+void test_boundaries()
+{
+    for (std::size_t len {0}; len <= 100; ++len)
+        for (std::size_t pos {0}; pos < std::max<std::size_t>(len, 1); ++pos)
+        {
+            std::string expanded (len, 'x');
+            if (len > 0)
+                expanded[pos] = '\n';
+            std::string compressed { expanded };
+            std::ranges::replace(compressed, '\n', Flattener::SUBTITUTION_STR);
+
+            assert(Flattener::flatten(expanded) == compressed);
+            assert(Flattener::expand(compressed) == expanded);
+            std::ostringstream oss {};
+            Flattener::flatten(std::string_view{ expanded }, oss);
+            assert(oss.str() == compressed);
+        }
+}
+
+/// Notes of many kilobytes (spanning many vector widths) survive a round trip.
+void test_long_notes()
+{
+    std::mt19937 gen { 42 };
+    std::uniform_int_distribution<int> letter { 'a', 'z' };
+    for (std::size_t const kib: { 4u, 64u, 1024u })
+    {
+        std::string notes (kib * 1024, ' ');
+        for (std::size_t i {0}; i < notes.size(); ++i)
+            notes[i] = (i % 73 == 72) ? '\n' : static_cast<char>(letter(gen));
+
+        std::string buf {};
+        Flattener::append_flattened(buf, notes);
+        std::string expanded {};
+        Flattener::append_expanded(expanded, buf);
+        assert(expanded == notes);
+    }
+}
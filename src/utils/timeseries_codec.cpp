@@ -0,0 +1,261 @@
+// timeseries_codec.cpp
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "timeseries_codec.hpp"
+//- STL
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+//- Third-party
+#include <cpperrors>
+
+
+using cpperrors::Exception;
+namespace
+{
+    constexpr auto low_mask(int num_bits) noexcept -> std::uint64_t
+    {
+        return num_bits >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << num_bits) - 1;
+    }
+
+    /// Interprets the low `num_bits` bits as a two's complement integer.
+    constexpr auto sign_extend(std::uint64_t bits, int num_bits) noexcept -> std::int64_t
+    {
+        auto const shift = 64 - num_bits;
+        return static_cast<std::int64_t>(bits << shift) >> shift;
+    }
+
+    /// Delta-of-delta buckets: a control prefix followed by a fixed-width value.
+    struct DodBucket
+    {
+        std::uint64_t prefix;
+        int prefix_bits;
+        int value_bits;
+    };
+    constexpr DodBucket DOD_BUCKETS[] {
+        { 0b10, 2, 7 },
+        { 0b110, 3, 9 },
+        { 0b1110, 4, 12 },
+        { 0b1111, 4, 64 },
+    };
+
+    // XOR encoding: the number of leading zeros is stored in 5 bits and the length of the
+    // meaningful bits (minus one) in 6 bits.
+    constexpr int LEADING_BITS { 5 };
+    constexpr int MAX_LEADING { (1 << LEADING_BITS) - 1 };
+    constexpr int LENGTH_BITS { 6 };
+}
+
+namespace utils
+{
+    /* BitWriter */
+    void BitWriter::write(std::uint64_t bits, int num_bits)
+    {
+        assert(num_bits >= 0 && num_bits <= 64);
+        bits &= low_mask(num_bits);
+        while (num_bits > 0)
+        {
+            // Move as many bits as fit into the accumulator, then drain whole bytes.
+            int const take = std::min(num_bits, 64 - d_acc_bits);
+            num_bits -= take;
+            std::uint64_t const chunk = (bits >> num_bits) & low_mask(take);
+            d_acc = (take == 64) ? chunk : (d_acc << take) | chunk;
+            d_acc_bits += take;
+            while (d_acc_bits >= 8)
+            {
+                d_acc_bits -= 8;
+                d_bytes.push_back(static_cast<char>((d_acc >> d_acc_bits) & 0xFF));
+            }
+            d_acc &= low_mask(d_acc_bits);
+        }
+    }
+
+    auto BitWriter::finish() -> std::string const&
+    {
+        if (d_acc_bits > 0)
+        {
+            d_bytes.push_back(static_cast<char>((d_acc << (8 - d_acc_bits)) & 0xFF));
+            d_acc = 0;
+            d_acc_bits = 0;
+        }
+        return d_bytes;
+    }
+
+    /* BitReader */
+    auto BitReader::load_word(std::size_t byte) const noexcept -> std::uint64_t
+    {
+        std::uint64_t word {};
+        if (d_bytes.size() - byte >= sizeof(word))
+        {
+            std::memcpy(&word, d_bytes.data() + byte, sizeof(word));
+            if constexpr (std::endian::native == std::endian::little)
+                word = std::byteswap(word);
+            return word;
+        }
+        for (std::size_t i {0}; i < sizeof(word); ++i)
+        {
+            word <<= 8;
+            if (byte + i < d_bytes.size())
+                word |= static_cast<unsigned char>(d_bytes[byte + i]);
+        }
+        return word;
+    }
+
+    auto BitReader::read(int num_bits) -> std::uint64_t
+    {
+        assert(num_bits >= 0 && num_bits <= 64);
+        if (num_bits == 0)
+            return 0;
+        if (static_cast<std::size_t>(num_bits) > d_total_bits - d_pos)
+            throw Exception("Unexpected end of encoded data.");
+        // A single word covers at most 57 bits past an arbitrary bit offset.
+        if (num_bits > 56)
+        {
+            auto const high = read(num_bits - 32);
+            return (high << 32) | read(32);
+        }
+        auto const word = load_word(d_pos / 8) << (d_pos % 8);
+        d_pos += static_cast<std::size_t>(num_bits);
+        return word >> (64 - num_bits);
+    }
+
+    /* TimeSeriesCodec */
+    void TimeSeriesCodec::encode_timestamps(std::span<std::int32_t const> values, BitWriter& out)
+    {
+        if (values.empty())
+            return;
+        out.write(static_cast<std::uint32_t>(values[0]), 32);
+        std::int64_t prev { values[0] };
+        std::int64_t prev_delta {};
+        for (auto const value: values.subspan(1))
+        {
+            std::int64_t const delta = value - prev;
+            std::int64_t const dod = delta - prev_delta;
+            if (dod == 0)
+                out.write(0, 1);
+            else
+            {
+                for (auto const& bucket: DOD_BUCKETS)
+                {
+                    if (bucket.value_bits == 64 || (sign_extend(static_cast<std::uint64_t>(dod), bucket.value_bits) == dod))
+                    {
+                        out.write(bucket.prefix, bucket.prefix_bits);
+                        out.write(static_cast<std::uint64_t>(dod), bucket.value_bits);
+                        break;
+                    }
+                }
+            }
+            prev = value;
+            prev_delta = delta;
+        }
+    }
+
+    void TimeSeriesCodec::decode_timestamps(BitReader& in, std::span<std::int32_t> out)
+    {
+        if (out.empty())
+            return;
+        std::int64_t prev { static_cast<std::int32_t>(static_cast<std::uint32_t>(in.read(32))) };
+        std::int64_t delta {};
+        out[0] = static_cast<std::int32_t>(prev);
+        for (auto& value: out.subspan(1))
+        {
+            if (in.read_bit())
+            {
+                // Count the remaining prefix ones to find the bucket.
+                std::size_t b {0};
+                while (b + 1 < std::size(DOD_BUCKETS) && in.read_bit())
+                    ++b;
+                auto const bits = DOD_BUCKETS[b].value_bits;
+                delta += sign_extend(in.read(bits), bits);
+            }
+            prev += delta;
+            value = static_cast<std::int32_t>(prev);
+        }
+    }
+
+    void TimeSeriesCodec::encode_values(std::span<double const> values, std::size_t stride, BitWriter& out)
+    {
+        assert(stride > 0);
+        if (values.empty())
+            return;
+        auto prev = std::bit_cast<std::uint64_t>(values[0]);
+        out.write(prev, 64);
+        int prev_leading { -1 };
+        int prev_trailing {};
+        for (std::size_t i {stride}; i < values.size(); i += stride)
+        {
+            auto const bits = std::bit_cast<std::uint64_t>(values[i]);
+            auto const diff = bits ^ prev;
+            prev = bits;
+            if (diff == 0)
+            {
+                out.write(0, 1);
+                continue;
+            }
+            int const leading = std::min(std::countl_zero(diff), MAX_LEADING);
+            int const trailing = std::countr_zero(diff);
+            if (prev_leading >= 0 && leading >= prev_leading && trailing >= prev_trailing)
+            {
+                // The meaningful bits fit within the previous window.
+                out.write(0b10, 2);
+                out.write(diff >> prev_trailing, 64 - prev_leading - prev_trailing);
+            }
+            else
+            {
+                int const length = 64 - leading - trailing;
+                out.write(0b11, 2);
+                out.write(static_cast<std::uint64_t>(leading), LEADING_BITS);
+                out.write(static_cast<std::uint64_t>(length - 1), LENGTH_BITS);
+                out.write(diff >> trailing, length);
+                prev_leading = leading;
+                prev_trailing = trailing;
+            }
+        }
+    }
+
+    void TimeSeriesCodec::decode_values(BitReader& in, std::span<double> out, std::size_t stride)
+    {
+        assert(stride > 0);
+        if (out.empty())
+            return;
+        auto prev = in.read(64);
+        out[0] = std::bit_cast<double>(prev);
+        int leading {};
+        int trailing {};
+        for (std::size_t i {stride}; i < out.size(); i += stride)
+        {
+            if (in.read_bit())
+            {
+                if (in.read_bit())
+                {
+                    leading = static_cast<int>(in.read(LEADING_BITS));
+                    int const length = static_cast<int>(in.read(LENGTH_BITS)) + 1;
+                    trailing = 64 - leading - length;
+                    if (trailing < 0)
+                        throw Exception("Corrupt encoded data.");
+                }
+                prev ^= in.read(64 - leading - trailing) << trailing;
+            }
+            out[i] = std::bit_cast<double>(prev);
+        }
+    }
+} // namespace utils
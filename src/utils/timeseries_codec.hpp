@@ -0,0 +1,106 @@
+// timeseries_codec.hpp
+/// Compact bit-level encodings for time series: delta-of-delta for integer timestamps and
+/// XOR encoding for floating-point values (see Pelkonen et al., "Gorilla: A Fast,
+/// Scalable, In-Memory Time Series Database", VLDB 2015).
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef INCLUDED_TIMESERIES_CODEC
+#define INCLUDED_TIMESERIES_CODEC
+
+#ifndef INCLUDED_STD_CSTDDEF
+#include <cstddef>
+#define INCLUDED_STD_CSTDDEF
+#endif
+
+#ifndef INCLUDED_STD_CSTDINT
+#include <cstdint>
+#define INCLUDED_STD_CSTDINT
+#endif
+
+#ifndef INCLUDED_STD_SPAN
+#include <span>
+#define INCLUDED_STD_SPAN
+#endif
+
+#ifndef INCLUDED_STD_STRING
+#include <string>
+#define INCLUDED_STD_STRING
+#endif
+
+#ifndef INCLUDED_STD_STRING_VIEW
+#include <string_view>
+#define INCLUDED_STD_STRING_VIEW
+#endif
+
+namespace utils
+{
+    /// Packs values into a byte string, most significant bit first.
+    class BitWriter
+    {
+        public:
+            /// Appends the low `num_bits` bits of `bits` (0 <= num_bits <= 64).
+            void write(std::uint64_t bits, int num_bits);
+            /// Flushes any partial byte (zero-padded) and returns the packed bytes.
+            auto finish() -> std::string const&;
+        private:
+            std::string d_bytes {};
+            std::uint64_t d_acc {};  // pending bits, right-aligned
+            int d_acc_bits {};
+    };
+
+    /// Reads values packed by a `BitWriter`. Reads past the end throw a
+    /// `cpperrors::Exception`.
+    class BitReader
+    {
+        public:
+            explicit BitReader(std::string_view bytes) noexcept
+                : d_bytes{ bytes }, d_total_bits{ bytes.size() * 8 } {}
+
+            /// Reads the next `num_bits` bits (0 <= num_bits <= 64).
+            auto read(int num_bits) -> std::uint64_t;
+            inline auto read_bit() -> bool { return read(1) != 0; }
+        private:
+            /// Returns the next 64 bits starting at the current byte, zero-filled past the
+            /// end of the input.
+            auto load_word(std::size_t byte) const noexcept -> std::uint64_t;
+
+            std::string_view d_bytes;
+            std::size_t d_total_bits;
+            std::size_t d_pos {};
+    };
+
+    /// Encoders for series whose consecutive values are similar.
+    ///
+    /// Timestamps are stored as the change between consecutive deltas, so a series
+    /// sampled at a fixed interval costs one bit per value after the first two. Values
+    /// are XORed with their predecessor and only the meaningful (non-zero) bits are kept,
+    /// so a repeated value costs one bit and a small change costs a few more.
+    struct TimeSeriesCodec
+    {
+        static void encode_timestamps(std::span<std::int32_t const> values, BitWriter& out);
+        /// Decodes `out.size()` timestamps.
+        static void decode_timestamps(BitReader& in, std::span<std::int32_t> out);
+
+        /// Encodes `values[0], values[stride], values[2*stride], ...` (ex. one column of a
+        /// row-major matrix).
+        static void encode_values(std::span<double const> values, std::size_t stride, BitWriter& out);
+        /// Decodes into `out[0], out[stride], ...`; the number of values decoded is the
+        /// number of strided positions in `out`.
+        static void decode_values(BitReader& in, std::span<double> out, std::size_t stride);
+    };
+} // namespace utils
+#endif // INCLUDED_TIMESERIES_CODEC
@@ -0,0 +1,143 @@
+// timeseries_codec.t.cpp
+// TimeSeriesCodec Test Driver
+/*
+* Copyright (C) 2024 Terrance Williams
+* 
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* 
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "timeseries_codec.hpp"
+//- STL
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+//- Third-party
+#include <cpperrors>
+
+
+using utils::BitReader, utils::BitWriter, utils::TimeSeriesCodec;
+void test_bits();
+void test_timestamps();
+void test_values();
+
+int main()
+{
+    try {
+        test_bits();
+        test_timestamps();
+        test_values();
+    } catch (cpperrors::Exception const& e) {
+        std::cerr << e.what() << "\n";
+        throw;
+    }
+}
+//--------------------------------------------------------------------------------------------------
+void test_bits()
+{
+    BitWriter out {};
+    out.write(0b1, 1);
+    out.write(0xABCD, 16);
+    out.write(0, 0);
+    out.write(0xDEADBEEFCAFEF00D, 64);
+    out.write(0b101, 3);
+    auto const& bytes = out.finish();
+    assert(bytes.size() == 11);  // 84 bits
+
+    BitReader in { bytes };
+    assert(in.read_bit());
+    assert(in.read(16) == 0xABCD);
+    assert(in.read(0) == 0);
+    assert(in.read(64) == 0xDEADBEEFCAFEF00D);
+    assert(in.read(3) == 0b101);
+    assert(in.read(4) == 0);  // padding
+    try {
+        in.read(1);
+        assert(false);
+    } catch (cpperrors::Exception const& e) {
+        std::cout << e.what() << "\n";
+    }
+}
+
+/// Round-trips timestamp series covering each delta-of-delta bucket.
+void test_timestamps()
+{
+    auto round_trip = [](std::vector<std::int32_t> const& values) {
+        BitWriter out {};
+        TimeSeriesCodec::encode_timestamps(values, out);
+        auto const bytes = out.finish();
+        BitReader in { bytes };
+        std::vector<std::int32_t> decoded(values.size());
+        TimeSeriesCodec::decode_timestamps(in, decoded);
+        assert(decoded == values);
+        return bytes.size();
+    };
+
+    // Daily samples: one bit per value after the second.
+    std::vector<std::int32_t> daily {};
+    for (std::int32_t d {19000}; d < 20000; ++d)
+        daily.push_back(d);
+    assert(round_trip(daily) < 4 + 2 + 1000 / 8 + 1);
+
+    std::vector<std::int32_t> irregular { -5, 0, 1, 3, 70, 71, 400, 401, 3000, 3001,
+        std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min(), 7 };
+    round_trip(irregular);
+    round_trip({});
+    round_trip({ 42 });
+
+    std::mt19937 gen { 7 };
+    std::uniform_int_distribution<std::int32_t> gap { 0, 5000 };
+    std::vector<std::int32_t> random { 0 };
+    for (int i {0}; i < 5000; ++i)
+        random.push_back(random.back() + gap(gen));
+    round_trip(random);
+}
+
+/// Round-trips strided value columns, including repeated values and special values.
+void test_values()
+{
+    constexpr std::size_t DIM { 3 };
+    std::mt19937 gen { 11 };
+    std::uniform_int_distribution<int> score { 0, 10 };
+    std::vector<double> rows {};
+    for (int i {0}; i < 2000; ++i)
+    {
+        rows.push_back(score(gen));           // small integers
+        rows.push_back(2.5);                  // constant
+        rows.push_back(i * 0.1 - 37.125);     // slowly changing
+    }
+    rows.insert(rows.end(), { 0., -0., std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::max(), 1e-300 });
+
+    BitWriter out {};
+    for (std::size_t col {0}; col < DIM; ++col)
+        TimeSeriesCodec::encode_values(std::span(rows).subspan(col), DIM, out);
+    auto const bytes = out.finish();
+    assert(bytes.size() < rows.size() * sizeof(double) / 2);
+
+    BitReader in { bytes };
+    std::vector<double> decoded(rows.size());
+    for (std::size_t col {0}; col < DIM; ++col)
+        TimeSeriesCodec::decode_values(in, std::span(decoded).subspan(col), DIM);
+    for (std::size_t i {0}; i < rows.size(); ++i)
+        assert(std::bit_cast<std::uint64_t>(decoded[i]) == std::bit_cast<std::uint64_t>(rows[i]));
+
+    // A constant column costs one bit per repeated value.
+    std::vector<double> constant(800, 3.75);
+    BitWriter flat {};
+    TimeSeriesCodec::encode_values(constant, 1, flat);
+    assert(flat.finish().size() == 8 + 100);
+}